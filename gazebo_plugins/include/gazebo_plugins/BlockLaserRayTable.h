@@ -0,0 +1,130 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROS_BLOCKLASERRAYTABLE_H
+#define ROS_BLOCKLASERRAYTABLE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+/// \brief Interpolation of the output points of a block laser between its
+/// rays along one direction.  The table depends only on the ray
+/// configuration and is only rebuilt when it changes.
+class BlockLaserRayTable
+{
+  private:
+    /// \brief Number of rays and angle limits the table was built for.
+    int rays_;
+    double min_angle_;
+    double max_angle_;
+    /// \brief Indices of the two rays each output point lies between.
+    std::vector<int> index_a_;
+    std::vector<int> index_b_;
+    /// \brief Interpolation weight of the ray at index_b.
+    std::vector<double> fraction_;
+    /// \brief Cosine and sine of the angle of each output point.
+    std::vector<double> cos_angle_;
+    std::vector<double> sin_angle_;
+
+  public:
+    /// \brief Constructor
+    BlockLaserRayTable()
+      : rays_(0), min_angle_(0.0), max_angle_(0.0)
+    {
+    }
+
+    /// \brief Rebuild the table if the ray configuration changed.
+    /// \param[in] rays Number of rays cast along the direction.
+    /// \param[in] ranges Number of output points along the direction.
+    /// \param[in] min_angle Angle of the first ray.
+    /// \param[in] max_angle Angle of the last ray.
+    void update(int rays, int ranges, double min_angle, double max_angle)
+    {
+      if (this->rays_ == rays &&
+          this->index_a_.size() == static_cast<size_t>(ranges) &&
+          this->min_angle_ == min_angle && this->max_angle_ == max_angle)
+        return;
+
+      this->rays_ = rays;
+      this->min_angle_ = min_angle;
+      this->max_angle_ = max_angle;
+      this->index_a_.resize(ranges);
+      this->index_b_.resize(ranges);
+      this->fraction_.resize(ranges);
+      this->cos_angle_.resize(ranges);
+      this->sin_angle_.resize(ranges);
+
+      for (int i = 0; i < ranges; i++)
+      {
+        // interpolating the output point between the two closest rays
+        double b = (ranges == 1) ? 0 : (double) i * (rays - 1) / (ranges - 1);
+        int ja = (int) floor(b);
+        int jb = std::min(ja + 1, rays - 1);
+
+        assert(ja >= 0 && ja < rays);
+        assert(jb >= 0 && jb < rays);
+
+        this->index_a_[i] = ja;
+        this->index_b_[i] = jb;
+        this->fraction_[i] = b - floor(b); // fraction from min
+
+        // angle of the output point
+        double angle = (rays == 1) ? min_angle :
+          0.5*(ja+jb) * (max_angle - min_angle) / (rays - 1) + min_angle;
+        this->cos_angle_[i] = cos(angle);
+        this->sin_angle_[i] = sin(angle);
+      }
+    }
+
+    /// \brief Number of output points.
+    int size() const { return static_cast<int>(this->index_a_.size()); }
+
+    /// \brief Cosine and sine of the angle of output point i.
+    double cosAngle(int i) const { return this->cos_angle_[i]; }
+    double sinAngle(int i) const { return this->sin_angle_[i]; }
+
+    /// \brief Interpolate output point (i, j) of a block scan from its four
+    /// neighbouring rays.
+    /// \param[in] h Horizontal table, indexed by i.
+    /// \param[in] v Vertical table, indexed by j.
+    /// \param[in] ranges Range of every ray, one row of h rays per
+    /// vertical ray.
+    /// \param[in] retros Retro value of every ray, stored like the ranges.
+    /// \param[out] range Bilinear interpolation of the four ranges.
+    /// \param[out] intensity Average of the four retro values.
+    static void interpolate(const BlockLaserRayTable &h,
+                            const BlockLaserRayTable &v,
+                            const double *ranges, const double *retros,
+                            int i, int j, double &range, double &intensity)
+    {
+      const int a = h.index_a_[i];
+      const int b = h.index_b_[i];
+      const double hb = h.fraction_[i];
+      const double vb = v.fraction_[j];
+      const int rowA = v.index_a_[j] * h.rays_;
+      const int rowB = v.index_b_[j] * h.rays_;
+
+      range = (1-vb)*((1 - hb) * ranges[rowA + a] + hb * ranges[rowA + b])
+            +   vb *((1 - hb) * ranges[rowB + a] + hb * ranges[rowB + b]);
+      intensity = 0.25*(retros[rowA + a] + retros[rowA + b] +
+                        retros[rowB + a] + retros[rowB + b]);
+    }
+};
+
+#endif
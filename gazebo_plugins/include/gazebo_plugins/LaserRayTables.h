@@ -0,0 +1,104 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROS_LASERRAYTABLES_H
+#define ROS_LASERRAYTABLES_H
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include <gazebo/msgs/msgs.hh>
+
+/// \brief Cosine and sine of the horizontal and vertical ray angles of a
+/// Gazebo laser scan, used to turn its ranges into points.  The tables
+/// are only rebuilt when the scan geometry changes.
+class LaserRayTables
+{
+  private:
+    /// \brief Cosine and sine of the yaw of each column and of the pitch
+    /// of each ring.
+    std::vector<float> cos_yaw_, sin_yaw_, cos_pitch_, sin_pitch_;
+    /// \brief Scan geometry the tables were built for.
+    double angle_min_, angle_step_;
+    double vertical_angle_min_, vertical_angle_step_;
+
+  public:
+    /// \brief Constructor
+    LaserRayTables()
+      : angle_min_(0.0), angle_step_(0.0),
+        vertical_angle_min_(0.0), vertical_angle_step_(0.0)
+    {
+    }
+
+    /// \brief Rebuild the tables if the geometry of a scan changed.
+    /// \param[in] scan Scan whose rays are converted next.
+    /// \return False if the scan holds no complete set of rays.
+    bool update(const gazebo::msgs::LaserScan &scan)
+    {
+      const unsigned int count = scan.count();
+      const unsigned int vertical_count =
+        std::max(static_cast<unsigned int>(scan.vertical_count()), 1u);
+      if (count == 0 ||
+          static_cast<unsigned int>(scan.ranges_size()) < count * vertical_count)
+        return false;
+
+      if (this->cos_yaw_.size() == count &&
+          this->cos_pitch_.size() == vertical_count &&
+          this->angle_min_ == scan.angle_min() &&
+          this->angle_step_ == scan.angle_step() &&
+          this->vertical_angle_min_ == scan.vertical_angle_min() &&
+          this->vertical_angle_step_ == scan.vertical_angle_step())
+        return true;
+
+      this->angle_min_ = scan.angle_min();
+      this->angle_step_ = scan.angle_step();
+      this->vertical_angle_min_ = scan.vertical_angle_min();
+      this->vertical_angle_step_ = scan.vertical_angle_step();
+
+      this->cos_yaw_.resize(count);
+      this->sin_yaw_.resize(count);
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        double yaw = scan.angle_min() + i * scan.angle_step();
+        this->cos_yaw_[i] = cos(yaw);
+        this->sin_yaw_[i] = sin(yaw);
+      }
+
+      // a single ring lies in the plane of the sensor
+      this->cos_pitch_.resize(vertical_count);
+      this->sin_pitch_.resize(vertical_count);
+      for (unsigned int j = 0; j < vertical_count; ++j)
+      {
+        double pitch = vertical_count > 1 ?
+          scan.vertical_angle_min() + j * scan.vertical_angle_step() : 0.0;
+        this->cos_pitch_[j] = cos(pitch);
+        this->sin_pitch_[j] = sin(pitch);
+      }
+      return true;
+    }
+
+    /// \brief Cosine and sine of the yaw of column i.
+    float cosYaw(unsigned int i) const { return this->cos_yaw_[i]; }
+    float sinYaw(unsigned int i) const { return this->sin_yaw_[i]; }
+
+    /// \brief Cosine and sine of the pitch of ring j.
+    float cosPitch(unsigned int j) const { return this->cos_pitch_[j]; }
+    float sinPitch(unsigned int j) const { return this->sin_pitch_[j]; }
+};
+
+#endif
@@ -0,0 +1,163 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROS_MESSAGEPOOL_H
+#define ROS_MESSAGEPOOL_H
+
+#include <stdint.h>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <gazebo_msgs/ContactsState.h>
+#include <gazebo_msgs/ModelContacts.h>
+#include <sensor_msgs/Image.h>
+#include <sensor_msgs/LaserScan.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <stereo_msgs/DisparityImage.h>
+
+/// \brief Payload buffer of the message types handled by MessagePool.
+inline std::vector<uint8_t> &MessagePayload(sensor_msgs::Image &msg)
+{
+  return msg.data;
+}
+inline std::vector<uint8_t> &MessagePayload(sensor_msgs::PointCloud2 &msg)
+{
+  return msg.data;
+}
+inline std::vector<uint8_t> &MessagePayload(stereo_msgs::DisparityImage &msg)
+{
+  return msg.image.data;
+}
+
+/// \brief Reserve the payload of a message for at least size bytes.
+template<class T>
+inline void ReservePayload(T &msg, size_t size)
+{
+  MessagePayload(msg).reserve(size);
+}
+inline void ReservePayload(sensor_msgs::LaserScan &msg, size_t size)
+{
+  // intensities are optional and grow on first use
+  msg.ranges.reserve(size / sizeof(float));
+}
+inline void ReservePayload(gazebo_msgs::ContactsState &msg, size_t size)
+{
+  // the contact points of each state grow on first use
+  msg.states.reserve(size / sizeof(gazebo_msgs::ContactState));
+}
+inline void ReservePayload(gazebo_msgs::ModelContacts &msg, size_t size)
+{
+  msg.states.reserve(size / sizeof(gazebo_msgs::ContactState));
+}
+
+/// \brief A pool of ROS messages with a large payload (images, point clouds,
+/// disparity images, laser scans, contacts).  Messages are handed out as shared
+/// pointers and can be handed out again once the publisher queue and all
+/// intra-process subscribers have released them.  In steady state a publisher acquiring,
+/// filling and publishing one message per frame reuses the same messages and
+/// payload buffers and does not allocate.
+///
+/// Messages are kept in buckets by the power of two size class of their
+/// payload capacity, so that a request is served by a buffer that already
+/// fits and differently sized outputs do not evict each other.
+/// Templated on a ROS message type with a ReservePayload() overload.
+template<class T>
+class MessagePool
+{
+  public:
+    typedef boost::shared_ptr<MessagePool<T> > Ptr;
+    typedef boost::shared_ptr<T> MessagePtr;
+
+  private:
+    /// \brief Number of size classes, enough for any 64 bit size.
+    static const unsigned int num_buckets_ = 64;
+
+    /// \brief Messages owned by the pool, indexed by size class.  A message
+    /// only referenced by the pool is free.
+    std::vector<MessagePtr> buckets_[num_buckets_];
+    /// \brief Mutex to control access to the buckets.
+    boost::mutex lock_;
+    /// \brief Maximum number of messages kept per size class.
+    size_t max_per_class_;
+    /// \brief Number of messages allocated by the pool.
+    size_t allocations_;
+
+    /// \brief Smallest size class holding at least size bytes.
+    static unsigned int sizeClass(size_t size)
+    {
+      unsigned int c = 0;
+      while (c < num_buckets_ - 1 && (static_cast<size_t>(1) << c) < size)
+        ++c;
+      return c;
+    }
+
+  public:
+    /// \brief Constructor
+    /// \param[in] max_per_class Maximum number of messages kept per size
+    /// class, should cover the publisher queue depth plus one.
+    explicit MessagePool(size_t max_per_class = 4) :
+      max_per_class_(max_per_class), allocations_(0)
+    {
+      for (unsigned int c = 0; c < num_buckets_; ++c)
+        buckets_[c].reserve(max_per_class_);
+    }
+
+    /// \brief Get a free message whose payload holds at least size bytes
+    /// without reallocating.  The payload content and size are left as they
+    /// were when the message was last used.
+    /// \param[in] size Payload size in bytes the caller is going to write.
+    /// \return Message that must not be modified after publishing it.
+    MessagePtr acquire(size_t size)
+    {
+      boost::mutex::scoped_lock lock(lock_);
+
+      // a message is released once the pool holds its only reference;
+      // payload capacity only grows, so every message of class c holds at
+      // least 2^c bytes
+      const unsigned int first = sizeClass(size);
+      for (unsigned int c = first; c < num_buckets_; ++c)
+      {
+        for (size_t i = 0; i < buckets_[c].size(); ++i)
+        {
+          if (buckets_[c][i].unique())
+            return buckets_[c][i];
+        }
+      }
+
+      ++allocations_;
+      MessagePtr msg(new T());
+      ReservePayload(*msg, static_cast<size_t>(1) << first);
+
+      // keep the new message unless its size class is full, in which case
+      // all pooled messages are in flight and it is handed out unpooled
+      if (buckets_[first].size() < max_per_class_)
+        buckets_[first].push_back(msg);
+      return msg;
+    }
+
+    /// \brief Number of messages allocated so far, stays constant once the
+    /// pool reached steady state.
+    size_t allocations()
+    {
+      boost::mutex::scoped_lock lock(lock_);
+      return allocations_;
+    }
+};
+
+#endif
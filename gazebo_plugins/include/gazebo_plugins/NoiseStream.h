@@ -0,0 +1,191 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROS_NOISESTREAM_H
+#define ROS_NOISESTREAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <cmath>
+#include <string>
+
+/// \brief Stream of random numbers for sensor noise, based on the Philox
+/// 4x32-10 counter based generator (Salmon et al., "Parallel random
+/// numbers: as easy as 1, 2, 3", SC'11).
+///
+/// Every value is a pure function of (seed, stream, position), so each
+/// sensor owns an independent stream that needs no locking and gives the
+/// same sequence regardless of how sensors are scheduled on threads.
+/// A stream must only be used by one thread at a time, typically it is
+/// a member of the plugin that adds the noise.
+///
+/// Gaussian samples use both outputs of the Box-Muller transform.
+class NoiseStream
+{
+  private:
+    /// \brief Generator key, derived from the seed.
+    uint32_t key_[2];
+    /// \brief Block counter, the upper half holds the stream id.
+    uint32_t counter_[4];
+    /// \brief Output of the current block.
+    uint32_t block_[4];
+    /// \brief Number of used words of the current block.
+    unsigned int used_;
+    /// \brief Second Box-Muller sample, valid if has_spare_ is set.
+    double spare_;
+    bool has_spare_;
+
+    /// \brief Multiply two words into a high and a low word.
+    static void mulhilo(uint32_t a, uint32_t b, uint32_t &hi, uint32_t &lo)
+    {
+      uint64_t product = static_cast<uint64_t>(a) * b;
+      hi = static_cast<uint32_t>(product >> 32);
+      lo = static_cast<uint32_t>(product);
+    }
+
+    /// \brief Compute the Philox 4x32-10 block of the current counter and
+    /// advance the counter.
+    void nextBlock()
+    {
+      uint32_t c[4] = {this->counter_[0], this->counter_[1],
+                       this->counter_[2], this->counter_[3]};
+      uint32_t k[2] = {this->key_[0], this->key_[1]};
+      for (unsigned int round = 0; round < 10; ++round)
+      {
+        uint32_t hi0, lo0, hi1, lo1;
+        mulhilo(0xD2511F53u, c[0], hi0, lo0);
+        mulhilo(0xCD9E8D57u, c[2], hi1, lo1);
+        c[0] = hi1 ^ c[1] ^ k[0];
+        c[1] = lo1;
+        c[2] = hi0 ^ c[3] ^ k[1];
+        c[3] = lo0;
+        k[0] += 0x9E3779B9u;
+        k[1] += 0xBB67AE85u;
+      }
+      for (unsigned int i = 0; i < 4; ++i)
+        this->block_[i] = c[i];
+      this->used_ = 0;
+
+      // 64 bit position within the stream
+      if (++this->counter_[0] == 0)
+        ++this->counter_[1];
+    }
+
+    /// \brief Next 64 random bits.
+    uint64_t next64()
+    {
+      if (this->used_ > 2)
+        this->nextBlock();
+      uint64_t value = (static_cast<uint64_t>(this->block_[this->used_]) << 32) |
+        this->block_[this->used_ + 1];
+      this->used_ += 2;
+      return value;
+    }
+
+  public:
+    /// \brief Constructor
+    /// \param[in] seed Seed shared by related streams, e.g. of one world.
+    /// \param[in] stream Id of this stream, e.g. derived from the sensor.
+    explicit NoiseStream(uint64_t seed = 0, uint64_t stream = 0)
+    {
+      this->seed(seed, stream);
+    }
+
+    /// \brief Restart the stream.
+    /// \param[in] seed Seed shared by related streams.
+    /// \param[in] stream Id of this stream.
+    void seed(uint64_t seed, uint64_t stream)
+    {
+      this->key_[0] = static_cast<uint32_t>(seed);
+      this->key_[1] = static_cast<uint32_t>(seed >> 32);
+      this->counter_[0] = 0;
+      this->counter_[1] = 0;
+      this->counter_[2] = static_cast<uint32_t>(stream);
+      this->counter_[3] = static_cast<uint32_t>(stream >> 32);
+      this->used_ = 4;
+      this->has_spare_ = false;
+      this->spare_ = 0.0;
+    }
+
+    /// \brief Stable 64 bit FNV-1a hash of a name, used to derive stream ids
+    /// from sensor names so they do not depend on the load order.
+    static uint64_t hashName(const std::string &name)
+    {
+      uint64_t hash = 0xCBF29CE484222325ull;
+      for (size_t i = 0; i < name.size(); ++i)
+      {
+        hash ^= static_cast<unsigned char>(name[i]);
+        hash *= 0x100000001B3ull;
+      }
+      return hash;
+    }
+
+    /// \brief Uniformly distributed value in (0, 1].
+    double uniform()
+    {
+      // 53 random bits, shifted away from 0 so that log() stays finite
+      return ((this->next64() >> 11) + 1) * (1.0 / 9007199254740992.0);
+    }
+
+    /// \brief Normally distributed value.
+    /// \param[in] mu Mean.
+    /// \param[in] sigma Standard deviation.
+    double gaussian(double mu, double sigma)
+    {
+      if (this->has_spare_)
+      {
+        this->has_spare_ = false;
+        return sigma * this->spare_ + mu;
+      }
+
+      // Box-Muller transform, keep the second sample for the next call
+      double radius = std::sqrt(-2.0 * std::log(this->uniform()));
+      double angle = 2.0 * M_PI * this->uniform();
+      this->spare_ = radius * std::sin(angle);
+      this->has_spare_ = true;
+      return sigma * radius * std::cos(angle) + mu;
+    }
+
+    /// \brief Add zero mean normally distributed noise to an array.
+    /// \param[in,out] values Values the noise is added to.
+    /// \param[in] count Number of values.
+    /// \param[in] sigma Standard deviation.
+    template<typename T>
+    void addGaussian(T *values, size_t count, double sigma)
+    {
+      size_t i = 0;
+      if (this->has_spare_ && count > 0)
+      {
+        values[i++] += sigma * this->spare_;
+        this->has_spare_ = false;
+      }
+
+      // two samples per pair of uniforms
+      for (; i + 1 < count; i += 2)
+      {
+        double radius = sigma * std::sqrt(-2.0 * std::log(this->uniform()));
+        double angle = 2.0 * M_PI * this->uniform();
+        values[i] += radius * std::cos(angle);
+        values[i + 1] += radius * std::sin(angle);
+      }
+
+      if (i < count)
+        values[i] += this->gaussian(0.0, sigma);
+    }
+};
+
+#endif
@@ -0,0 +1,241 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#ifndef ROS_POINTCLOUD2LAYOUT_H
+#define ROS_POINTCLOUD2LAYOUT_H
+
+#include <stdint.h>
+#include <string.h>
+#include <sstream>
+#include <string>
+
+#include <sensor_msgs/PointCloud2.h>
+#include <sensor_msgs/PointField.h>
+
+/// \brief Point layout of laser point clouds written directly into a
+/// sensor_msgs::PointCloud2 buffer.  The selectable fields follow the
+/// layout of velodyne_pointcloud:
+///   x, y, z      float32  position in the sensor frame
+///   intensity    float32  return intensity
+///   ring         uint16   index of the vertical beam, 0 being the lowest
+///   time         float32  time of the ray relative to the header stamp,
+///                         only meaningful for rolling scans
+class PointCloud2Layout
+{
+  public:
+    /// \brief Selectable fields, combined as a bit mask.
+    enum Field
+    {
+      XYZ = 1,
+      INTENSITY = 2,
+      RING = 4,
+      TIME = 8
+    };
+
+  private:
+    /// \brief Enabled fields.
+    unsigned int fields_;
+    /// \brief Byte offsets of the enabled fields within a point.
+    uint32_t intensity_offset_;
+    uint32_t ring_offset_;
+    uint32_t time_offset_;
+    /// \brief Size of a point in bytes.
+    uint32_t point_step_;
+
+    /// \brief Round an offset up to the alignment of a field.
+    static uint32_t align(uint32_t offset, uint32_t size)
+    {
+      return (offset + size - 1) / size * size;
+    }
+
+    /// \brief Append a field description to a message.
+    static void addField(sensor_msgs::PointCloud2 &msg, const std::string &name,
+                         uint32_t offset, uint8_t datatype)
+    {
+      sensor_msgs::PointField field;
+      field.name = name;
+      field.offset = offset;
+      field.datatype = datatype;
+      field.count = 1;
+      msg.fields.push_back(field);
+    }
+
+    /// \brief True if a field description matches a field of the layout.
+    static bool isField(const sensor_msgs::PointField &field,
+                        const std::string &name, uint32_t offset,
+                        uint8_t datatype)
+    {
+      return field.name == name && field.offset == offset &&
+        field.datatype == datatype && field.count == 1;
+    }
+
+    /// \brief True if the field description of a message matches the
+    /// layout, in order, names, offsets and datatypes.
+    bool describes(const sensor_msgs::PointCloud2 &msg) const
+    {
+      size_t num_fields = 3 + (this->has(INTENSITY) ? 1 : 0) +
+        (this->has(RING) ? 1 : 0) + (this->has(TIME) ? 1 : 0);
+      if (msg.fields.size() != num_fields || msg.point_step != this->point_step_)
+        return false;
+
+      const sensor_msgs::PointField *field = &msg.fields[0];
+      if (!isField(*field++, "x", 0, sensor_msgs::PointField::FLOAT32) ||
+          !isField(*field++, "y", sizeof(float), sensor_msgs::PointField::FLOAT32) ||
+          !isField(*field++, "z", 2 * sizeof(float), sensor_msgs::PointField::FLOAT32))
+        return false;
+      if (this->has(INTENSITY) &&
+          !isField(*field++, "intensity", this->intensity_offset_,
+                   sensor_msgs::PointField::FLOAT32))
+        return false;
+      if (this->has(RING) &&
+          !isField(*field++, "ring", this->ring_offset_,
+                   sensor_msgs::PointField::UINT16))
+        return false;
+      if (this->has(TIME) &&
+          !isField(*field++, "time", this->time_offset_,
+                   sensor_msgs::PointField::FLOAT32))
+        return false;
+      return true;
+    }
+
+  public:
+    /// \brief Constructor
+    /// \param[in] fields Bit mask of Field values, xyz is always written.
+    explicit PointCloud2Layout(unsigned int fields = XYZ | INTENSITY)
+    {
+      this->setFields(fields);
+    }
+
+    /// \brief Parse a field list such as "xyz intensity ring time",
+    /// names may be separated by spaces or commas.
+    /// \param[in] spec Field list.
+    /// \param[out] fields Bit mask of the listed fields.
+    /// \return False if the list contains an unknown name.
+    static bool parseFields(const std::string &spec, unsigned int &fields)
+    {
+      std::string names = spec;
+      for (size_t i = 0; i < names.size(); ++i)
+      {
+        if (names[i] == ',')
+          names[i] = ' ';
+      }
+
+      fields = XYZ;
+      std::istringstream stream(names);
+      std::string name;
+      while (stream >> name)
+      {
+        if (name == "xyz")
+          fields |= XYZ;
+        else if (name == "intensity")
+          fields |= INTENSITY;
+        else if (name == "ring")
+          fields |= RING;
+        else if (name == "time")
+          fields |= TIME;
+        else
+          return false;
+      }
+      return true;
+    }
+
+    /// \brief Select the fields and compute their offsets.
+    void setFields(unsigned int fields)
+    {
+      this->fields_ = fields | XYZ;
+      uint32_t offset = 3 * sizeof(float);
+      if (this->fields_ & INTENSITY)
+      {
+        this->intensity_offset_ = offset;
+        offset += sizeof(float);
+      }
+      if (this->fields_ & RING)
+      {
+        this->ring_offset_ = offset;
+        offset += sizeof(uint16_t);
+      }
+      if (this->fields_ & TIME)
+      {
+        offset = align(offset, sizeof(float));
+        this->time_offset_ = offset;
+        offset += sizeof(float);
+      }
+      this->point_step_ = align(offset, sizeof(float));
+    }
+
+    /// \brief True if a field is written.
+    bool has(Field field) const
+    {
+      return (this->fields_ & field) != 0;
+    }
+
+    /// \brief Size of a point in bytes.
+    uint32_t pointStep() const
+    {
+      return this->point_step_;
+    }
+
+    /// \brief Size a message for an organized cloud and describe its
+    /// fields.  The field description is only rewritten when it changed,
+    /// the data buffer only grows, so a reused message does not allocate.
+    void init(sensor_msgs::PointCloud2 &msg, uint32_t width,
+              uint32_t height) const
+    {
+      if (!this->describes(msg))
+      {
+        msg.fields.clear();
+        addField(msg, "x", 0, sensor_msgs::PointField::FLOAT32);
+        addField(msg, "y", sizeof(float), sensor_msgs::PointField::FLOAT32);
+        addField(msg, "z", 2 * sizeof(float), sensor_msgs::PointField::FLOAT32);
+        if (this->has(INTENSITY))
+          addField(msg, "intensity", this->intensity_offset_,
+                   sensor_msgs::PointField::FLOAT32);
+        if (this->has(RING))
+          addField(msg, "ring", this->ring_offset_,
+                   sensor_msgs::PointField::UINT16);
+        if (this->has(TIME))
+          addField(msg, "time", this->time_offset_,
+                   sensor_msgs::PointField::FLOAT32);
+      }
+
+      msg.width = width;
+      msg.height = height;
+      msg.is_bigendian = false;
+      msg.point_step = this->point_step_;
+      msg.row_step = this->point_step_ * width;
+      msg.data.resize(static_cast<size_t>(msg.row_step) * height);
+    }
+
+    /// \brief Write one point, fields that are not enabled are skipped.
+    /// \param[in] point Start of the point in the message data.
+    void write(uint8_t *point, float x, float y, float z, float intensity,
+               uint16_t ring, float time) const
+    {
+      float *xyz = reinterpret_cast<float*>(point);
+      xyz[0] = x;
+      xyz[1] = y;
+      xyz[2] = z;
+      if (this->fields_ & INTENSITY)
+        memcpy(point + this->intensity_offset_, &intensity, sizeof(float));
+      if (this->fields_ & RING)
+        memcpy(point + this->ring_offset_, &ring, sizeof(uint16_t));
+      if (this->fields_ & TIME)
+        memcpy(point + this->time_offset_, &time, sizeof(float));
+    }
+};
+
+#endif
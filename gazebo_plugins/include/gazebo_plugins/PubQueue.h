@@ -33,11 +33,14 @@ template<class T>
 class PubMessagePair
 {
   public:
-    /// \brief The outgoing message.
-    T msg_;
+    /// \brief The outgoing message, shared with the publisher and
+    /// intra-process subscribers.
+    boost::shared_ptr<const T> msg_;
     /// \brief The publisher to use to publish the message.
     ros::Publisher pub_;
     PubMessagePair(T& msg, ros::Publisher& pub) :
+      msg_(new T(msg)), pub_(pub) {}
+    PubMessagePair(const boost::shared_ptr<const T>& msg, ros::Publisher& pub) :
       msg_(msg), pub_(pub) {}
 };
 
@@ -78,6 +81,19 @@ class PubQueue
       notify_func_();
     }
 
+    /// \brief Push a new message onto the queue without copying it.  The
+    /// message must not be modified afterwards, e.g. take it from a
+    /// MessagePool and acquire a new one for the next update.
+    /// \param[in] msg The outgoing message
+    /// \param[in] pub The ROS publisher to use to publish the message
+    void push(const boost::shared_ptr<const T>& msg, ros::Publisher& pub)
+    {
+      boost::shared_ptr<PubMessagePair<T> > el(new PubMessagePair<T>(msg, pub));
+      boost::mutex::scoped_lock lock(*queue_lock_);
+      queue_->push_back(el);
+      notify_func_();
+    }
+
     /// \brief Pop all waiting messages off the queue.
     /// \param[out] els Place to store the popped messages
     void pop(std::vector<boost::shared_ptr<PubMessagePair<T> > >& els)
@@ -42,6 +42,13 @@
 #include <boost/thread/mutex.hpp>
 
 #include <sensor_msgs/PointCloud.h>
+#include <sensor_msgs/PointCloud2.h>
+
+#include <gazebo_plugins/BlockLaserRayTable.h>
+#include <gazebo_plugins/NoiseStream.h>
+#include <gazebo_plugins/PointCloud2Layout.h>
+
+#include <vector>
 
 namespace gazebo
 {
@@ -65,6 +72,14 @@ namespace gazebo
     /// \brief Put laser data to the ROS topic
     private: void PutLaserData(common::Time &_updateTime);
 
+    /// \brief Horizontal and vertical interpolation tables
+    private: BlockLaserRayTable horizontal_table_;
+    private: BlockLaserRayTable vertical_table_;
+
+    /// \brief Range and retro of every ray, fetched once per scan
+    private: std::vector<double> ranges_;
+    private: std::vector<double> retros_;
+
     private: common::Time last_update_time_;
 
     /// \brief Keep track of number of connctions
@@ -85,6 +100,15 @@ namespace gazebo
     /// \brief ros message
     private: sensor_msgs::PointCloud cloud_msg_;
 
+    /// \brief Publish a PointCloud2 instead of a PointCloud
+    private: bool output_point_cloud2_;
+
+    /// \brief Fields of the PointCloud2 output
+    private: PointCloud2Layout cloud2_layout_;
+
+    /// \brief ros message of the PointCloud2 output
+    private: sensor_msgs::PointCloud2 cloud2_msg_;
+
     /// \brief topic name
     private: std::string topic_name_;
 
@@ -95,7 +119,7 @@ namespace gazebo
     private: double gaussian_noise_;
 
     /// \brief Gaussian noise generator
-    private: double GaussianKernel(double mu,double sigma);
+    private: NoiseStream noise_;
 
     /// \brief A mutex to lock access to fields that are used in message callbacks
     private: boost::mutex lock;
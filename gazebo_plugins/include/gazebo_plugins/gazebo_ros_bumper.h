@@ -33,6 +33,7 @@
 
 #include <std_msgs/String.h>
 
+#include <gazebo_msgs/ContactMask.h>
 #include <gazebo_msgs/ContactState.h>
 #include <gazebo_msgs/ContactsState.h>
 
@@ -46,12 +47,36 @@
 #include <gazebo/sensors/SensorTypes.hh>
 #include <gazebo/sensors/ContactSensor.hh>
 #include <gazebo/common/Plugin.hh>
+#include <ignition/math/Pose3.hh>
+
+#include <gazebo_plugins/MessagePool.h>
+#include <gazebo_plugins/PubQueue.h>
 
 namespace gazebo
 {
   /// \brief A Bumper controller
+  ///
+  /// <outputMode> selects what is published on <bumperTopicName>:
+  /// - raw (default): a gazebo_msgs/ContactsState with every contact point
+  ///   of every collision pair
+  /// - aggregated: a gazebo_msgs/ContactsState with one entry per collision
+  ///   pair holding the net wrench, the centroid of the contact points,
+  ///   their mean normal and their largest depth
+  /// - touch: a gazebo_msgs/ContactMask telling which collisions of the
+  ///   sensor touch anything
   class GazeboRosBumper : public SensorPlugin
   {
+    /// \brief Content of the published messages
+    public: enum OutputMode
+    {
+      /// \brief Every contact point
+      RAW,
+      /// \brief One reading per collision pair
+      AGGREGATED,
+      /// \brief One flag per collision of the sensor
+      TOUCH
+    };
+
     /// Constructor
     public: GazeboRosBumper();
 
@@ -62,6 +87,59 @@ namespace gazebo
     /// \param take in SDF root element
     public: void Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf);
 
+    /// \brief Convert the contacts of a sensor update to a ContactsState
+    /// message.  The header is left to the caller.
+    /// \param[in] _contacts Contacts reported by the sensor
+    /// \param[in] _frame_pose Pose of the frame of the message in world
+    /// \param[out] _msg Message to fill, its arrays are reused
+    public: static void FillContactsState(const msgs::Contacts &_contacts,
+                const ignition::math::Pose3d &_frame_pose,
+                gazebo_msgs::ContactsState &_msg);
+
+    /// \brief Convert the contacts of a sensor update to a ContactsState
+    /// message with one reading per collision pair: total_wrench and
+    /// wrenches[0] hold the net wrench, contact_positions[0] the centroid,
+    /// contact_normals[0] the mean normal and depths[0] the largest depth.
+    /// The header is left to the caller.
+    /// \param[in] _contacts Contacts reported by the sensor
+    /// \param[in] _frame_pose Pose of the frame of the message in world
+    /// \param[out] _msg Message to fill, its arrays are reused
+    public: static void AggregateContactsState(
+                const msgs::Contacts &_contacts,
+                const ignition::math::Pose3d &_frame_pose,
+                gazebo_msgs::ContactsState &_msg);
+
+    /// \brief Convert the contact points of one collision pair, like
+    /// FillContactsState without the info text.
+    /// \param[in] _contact Contact points of a collision pair
+    /// \param[in] _frame_pose Pose of the frame of the message in world
+    /// \param[out] _state State to fill, its arrays are reused
+    /// \param[in] _swapped Report the pair from collision2: the names are
+    /// swapped, the wrench is the one on body 2 and the normals are negated
+    public: static void FillContactState(const msgs::Contact &_contact,
+                const ignition::math::Pose3d &_frame_pose,
+                gazebo_msgs::ContactState &_state,
+                bool _swapped = false);
+
+    /// \brief Reduce the contact points of one collision pair to one
+    /// reading, like AggregateContactsState.
+    /// \param[in] _contact Contact points of a collision pair
+    /// \param[in] _frame_pose Pose of the frame of the message in world
+    /// \param[out] _state State to fill, its arrays are reused
+    /// \param[in] _swapped Report the pair from collision2, like
+    /// FillContactState
+    public: static void AggregateContactState(const msgs::Contact &_contact,
+                const ignition::math::Pose3d &_frame_pose,
+                gazebo_msgs::ContactState &_state,
+                bool _swapped = false);
+
+    /// \brief Flag the collisions of _msg.collision_names that are part of
+    /// a contact.  The header is left to the caller.
+    /// \param[in] _contacts Contacts reported by the sensor
+    /// \param[in,out] _msg Message with the collision names to flag
+    public: static void FillContactMask(const msgs::Contacts &_contacts,
+                gazebo_msgs::ContactMask &_msg);
+
     /// Update the controller
     private: void OnContact();
 
@@ -76,8 +154,17 @@ namespace gazebo
 
     private: std::string frame_name_;
 
-    /// \brief broadcast some string for now.
-    private: gazebo_msgs::ContactsState contact_state_msg_;
+    /// \brief Reused contact messages, the latest one may still be in the
+    /// publisher queue
+    private: MessagePool<gazebo_msgs::ContactsState> contact_state_pool_;
+    private: PubQueue<gazebo_msgs::ContactsState>::Ptr contact_pub_queue_;
+
+    /// \brief Content of the published messages
+    private: OutputMode output_mode_;
+
+    /// \brief Touch output, holds the collision names of the sensor
+    private: gazebo_msgs::ContactMask contact_mask_msg_;
+    private: PubQueue<gazebo_msgs::ContactMask>::Ptr contact_mask_pub_queue_;
 
     /// \brief for setting ROS name space
     private: std::string robot_namespace_;
@@ -88,6 +175,9 @@ namespace gazebo
 
     // Pointer to the update event connection
     private: event::ConnectionPtr update_connection_;
+
+    // ros publish multi queue, prevents publish() blocking
+    private: PubMultiQueue pmq;
   };
 }
 
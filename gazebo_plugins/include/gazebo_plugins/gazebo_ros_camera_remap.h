@@ -0,0 +1,90 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_ROS_CAMERA_REMAP_HH
+#define GAZEBO_ROS_CAMERA_REMAP_HH
+
+#include <stdint.h>
+#include <vector>
+
+namespace gazebo
+{
+  /// \brief Precomputed bilinear remap table between a distorted and a
+  /// rectified pinhole image, following the plumb_bob model used in
+  /// sensor_msgs/CameraInfo.
+  ///
+  /// The table stores for every destination pixel the offset of the top
+  /// left source pixel and four fixed-point bilinear weights, so applying
+  /// it costs a handful of integer multiply-adds per channel and no
+  /// floating point or distortion model evaluation per frame.
+  class GazeboRosCameraRemap
+  {
+    /// \brief Direction of the remap
+    public: enum Direction
+    {
+      /// \brief Destination is the rectified image of a distorted source
+      RECTIFY,
+      /// \brief Destination is the distorted image of a rectified source
+      DISTORT
+    };
+
+    /// \brief Constructor
+    public: GazeboRosCameraRemap();
+
+    /// \brief Build the remap table, both images share the intrinsics.
+    /// \param[in] _width Image width in pixels.
+    /// \param[in] _height Image height in pixels.
+    /// \param[in] _focal_length Focal length in pixels.
+    /// \param[in] _cx Principal point x coordinate in pixels.
+    /// \param[in] _cy Principal point y coordinate in pixels.
+    /// \param[in] _d Distortion coefficients {k1, k2, t1, t2, k3}.
+    /// \param[in] _direction Which image is produced from which.
+    public: void Build(unsigned int _width, unsigned int _height,
+                       double _focal_length, double _cx, double _cy,
+                       const double _d[5], Direction _direction);
+
+    /// \brief Remap an image.  Destination pixels whose source lies outside
+    /// of the image are set to zero.
+    /// \param[in] _src Source image, row major without padding.
+    /// \param[out] _dst Destination image of the same size and layout.
+    /// \param[in] _channels Number of interleaved channels per pixel.
+    /// \param[in] _bytes_per_channel 1 for 8 bit or 2 for 16 bit channels.
+    public: void Apply(const unsigned char *_src, unsigned char *_dst,
+                       unsigned int _channels,
+                       unsigned int _bytes_per_channel) const;
+
+    /// \brief True once a table has been built.
+    public: bool Valid() const;
+
+    /// \brief Templated remap kernel for 8 and 16 bit channels.
+    private: template<typename T>
+             void ApplyChannels(const T *_src, T *_dst,
+                                unsigned int _channels) const;
+
+    /// \brief Image size of the table.
+    private: unsigned int width_, height_;
+
+    /// \brief Source pixel index of the top left neighbour of every
+    /// destination pixel, -1 when the source lies outside of the image.
+    private: std::vector<int32_t> offsets_;
+
+    /// \brief Bilinear weights of the top left, top right, bottom left and
+    /// bottom right neighbours, summing up to 1 << weight_bits.
+    private: std::vector<uint16_t> w00_, w01_, w10_, w11_;
+  };
+}
+#endif
@@ -0,0 +1,119 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef GAZEBO_ROS_CAMERA_TRIGGER_BROKER_HH
+#define GAZEBO_ROS_CAMERA_TRIGGER_BROKER_HH
+
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/thread.hpp>
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <std_msgs/String.h>
+#include <gazebo_msgs/CameraTriggerLatency.h>
+
+#include <gazebo/common/Plugin.hh>
+#include <gazebo/common/Events.hh>
+#include <gazebo/common/Time.hh>
+#include <gazebo/physics/physics.hh>
+
+namespace gazebo
+{
+  /// \brief World plugin triggering groups of triggered cameras in a single
+  /// render pass.
+  ///
+  /// Cameras loaded with gazebo_ros_triggered_camera or
+  /// gazebo_ros_triggered_multicamera join a group through <triggerGroup>.
+  /// Publishing the group name on the trigger topic triggers all of them at
+  /// the same sim instant. Once every camera published its frame, the
+  /// trigger-to-publish latency of each camera is published.
+  ///
+  /// Example Usage:
+  /// \verbatim
+  ///   <plugin name="camera_trigger_broker"
+  ///       filename="libgazebo_ros_camera_trigger_broker.so">
+  ///     <robotNamespace></robotNamespace>
+  ///     <triggerTopicName>trigger_camera_group</triggerTopicName>
+  ///     <latencyTopicName>camera_trigger_latency</latencyTopicName>
+  ///   </plugin>
+  /// \endverbatim
+  class GazeboRosCameraTriggerBroker : public WorldPlugin
+  {
+    /// \brief Constructor
+    public: GazeboRosCameraTriggerBroker();
+
+    /// \brief Destructor
+    public: virtual ~GazeboRosCameraTriggerBroker();
+
+    /// \brief Load the plugin
+    public: void Load(physics::WorldPtr _world, sdf::ElementPtr _sdf);
+
+    /// \brief Queue a group trigger for the next render pass
+    private: void OnTrigger(const std_msgs::String::ConstPtr &_msg);
+
+    /// \brief Trigger all queued groups
+    private: void PreRender();
+
+    /// \brief Record the latency of a camera that published its frame
+    private: void OnPublished(const std::string &_group,
+                 const std::string &_camera);
+
+    /// \brief Publish the latencies of a group trigger
+    private: void PublishLatency(gazebo_msgs::CameraTriggerLatency &_msg);
+
+    /// \brief Custom callback queue thread
+    private: void QueueThread();
+
+    /// \brief A trigger request waiting for the next render pass
+    private: struct TriggerRequest
+    {
+      std::string group;
+      common::Time sim_time;
+      common::Time wall_time;
+    };
+
+    /// \brief A triggered group waiting for its cameras to publish
+    private: struct TriggeredGroup
+    {
+      common::Time sim_time;
+      common::Time wall_time;
+      unsigned int remaining;
+      gazebo_msgs::CameraTriggerLatency msg;
+    };
+
+    private: physics::WorldPtr world_;
+
+    private: ros::NodeHandle* rosnode_;
+    private: ros::Subscriber trigger_sub_;
+    private: ros::Publisher latency_pub_;
+    private: ros::CallbackQueue queue_;
+    private: boost::thread callback_queue_thread_;
+
+    /// \brief A mutex to lock access to the trigger requests
+    private: std::mutex mutex_;
+    private: std::vector<TriggerRequest> pending_;
+    private: std::map<std::string, TriggeredGroup> triggered_;
+
+    private: event::ConnectionPtr pre_render_connection_;
+    private: event::ConnectionPtr published_connection_;
+  };
+}
+#endif
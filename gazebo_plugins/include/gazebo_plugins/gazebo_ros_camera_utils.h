@@ -48,6 +48,8 @@
 #include <gazebo/common/Time.hh>
 #include <gazebo/sensors/SensorTypes.hh>
 #include <gazebo_plugins/gazebo_ros_utils.h>
+#include <gazebo_plugins/MessagePool.h>
+#include <gazebo_plugins/gazebo_ros_camera_remap.h>
 
 namespace gazebo
 {
@@ -110,9 +112,41 @@ namespace gazebo
     protected: image_transport::Publisher image_pub_;
     private: image_transport::ImageTransport* itnode_;
 
-    /// \brief ROS image message
+    /// \brief ROS image message, kept for derived plugins filling their own
+    /// images. PutCameraData publishes messages from image_pool_.
     protected: sensor_msgs::Image image_msg_;
 
+    /// \brief Pool of image messages published by PutCameraData
+    protected: MessagePool<sensor_msgs::Image> image_pool_;
+
+    /// \brief Last image published by PutCameraData
+    protected: sensor_msgs::ImageConstPtr last_image_;
+
+    /// \brief Publisher of the rectified image, only advertised if
+    /// <rectifiedImageTopicName> is set.
+    private: image_transport::Publisher rect_pub_;
+
+    /// \brief ROS rectified image topic name, empty if disabled
+    private: std::string rect_image_topic_name_;
+
+    /// \brief Apply the plugin distortion coefficients to the rendered
+    /// image instead of relying on the gazebo lens distortion.
+    private: bool distort_image_;
+
+    /// \brief Remap table between distorted and rectified images
+    private: GazeboRosCameraRemap remap_;
+
+    /// \brief Pool of second images of a rectified / distorted pair
+    private: MessagePool<sensor_msgs::Image> remap_pool_;
+
+    /// \brief Build the remap table from the distortion coefficients
+    private: void InitRemap();
+
+    /// \brief Get a pooled image with header and layout set, its data
+    /// is resized but not filled.
+    private: sensor_msgs::ImagePtr AcquireImage(
+                 MessagePool<sensor_msgs::Image> &_pool);
+
     /// \brief for setting ROS name space
     private: std::string robot_namespace_;
 
@@ -35,8 +35,7 @@
 #include <sensor_msgs/fill_image.h>
 #include <std_msgs/Float64.h>
 #include <image_transport/image_transport.h>
-#include <visualization_msgs/MarkerArray.h>
-#include <visualization_msgs/Marker.h>
+#include <stereo_msgs/DisparityImage.h>
 
 // gazebo stuff
 #include <sdf/Param.hh>
@@ -108,6 +107,19 @@ namespace gazebo
     /// \brief push depth image data into ros topic
     private: void FillDepthImage(const float *_src);
 
+    /// \brief push disparity image data into ros topic
+    private: void FillDisparityImage(const float *_src);
+
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+    /// \brief push normals and their points into ros topic
+    private: void FillNormals(const float *_normals,
+                              unsigned int _width, unsigned int _height);
+
+    /// \brief Connect to the reflectance and normals frames of the depth
+    /// camera while they have subscribers, disconnect otherwise.
+    private: void UpdateAuxiliaryConnections();
+#endif
+
     /// \brief Keep track of number of connctions for point clouds
     private: int point_cloud_connect_count_;
     private: void PointCloudConnect();
@@ -131,6 +143,11 @@ namespace gazebo
     private: int depth_image_connect_count_;
     private: void DepthImageConnect();
     private: void DepthImageDisconnect();
+
+    /// \brief Keep track of number of connections for disparity images
+    private: int disparity_connect_count_;
+    private: void DisparityConnect();
+    private: void DisparityDisconnect();
     private: common::Time last_depth_image_camera_info_update_time_;
 
     private: bool FillPointCloudHelper(sensor_msgs::PointCloud2 &point_cloud_msg,
@@ -146,18 +163,22 @@ namespace gazebo
     private: ros::Publisher depth_image_pub_;
     private: ros::Publisher reflectance_pub_;
     private: ros::Publisher normal_pub_;
+    private: ros::Publisher disparity_pub_;
 
-    /// \brief PointCloud2 point cloud message
-    private: sensor_msgs::PointCloud2 point_cloud_msg_;
-    private: sensor_msgs::Image depth_image_msg_;
-    private: sensor_msgs::Image reflectance_msg_;
+    /// \brief Pools of the published messages, a message is reused once
+    /// all subscribers released it
+    private: MessagePool<sensor_msgs::PointCloud2> point_cloud_pool_;
+    private: MessagePool<sensor_msgs::Image> depth_image_pool_;
+    private: MessagePool<sensor_msgs::Image> reflectance_pool_;
+    private: MessagePool<stereo_msgs::DisparityImage> disparity_pool_;
+    private: MessagePool<sensor_msgs::PointCloud2> normals_pool_;
 
     /// \brief copy of the pointcloud data, used to place normals in the world
     private: float * pcd_ = nullptr;
 
     private: double point_cloud_cutoff_;
 
-    /// \brief adding one value each reduce_normals_ to the array marker
+    /// \brief adding one point each reduce_normals_ to the normals cloud
     private: int reduce_normals_;
 
     /// \brief ROS image topic name
@@ -169,6 +190,12 @@ namespace gazebo
     /// \brief ROS normals topic name
     private: std::string normals_topic_name_;
 
+    /// \brief ROS disparity image topic name
+    private: std::string disparity_topic_name_;
+
+    /// \brief Baseline used to convert depth into disparity
+    private: double disparity_baseline_;
+
     private: void InfoConnect();
     private: void InfoDisconnect();
 
@@ -69,6 +69,10 @@ namespace gazebo {
 
   class Joint;
   class Entity;
+  // Joint states shared with the other plugins of the model, defined in
+  // <gazebo_ros/joint_state_cache.h>
+  class JointStateCache;
+  typedef boost::shared_ptr<JointStateCache> JointStateCachePtr;
 
   class GazeboRosDiffDrive : public ModelPlugin {
 
@@ -114,6 +118,8 @@ namespace gazebo {
       boost::shared_ptr<tf::TransformBroadcaster> transform_broadcaster_;
       sensor_msgs::JointState joint_state_;
       ros::Publisher joint_state_publisher_;
+      JointStateCachePtr joint_state_cache_;
+      std::vector<unsigned int> joint_state_indices_;
       nav_msgs::Odometry odom_;
       std::string tf_prefix_;
 
@@ -37,6 +37,8 @@
 #include <boost/thread/mutex.hpp>
 #include <geometry_msgs/WrenchStamped.h>
 
+#include <gazebo_plugins/NoiseStream.h>
+
 namespace gazebo
 {
 /// @addtogroup gazebo_dynamic_plugins Gazebo ROS Dynamic Plugins
@@ -90,7 +92,7 @@ class GazeboRosFT : public ModelPlugin
   private: double gaussian_noise_;
 
   /// \brief Gaussian noise generator
-  private: double GaussianKernel(double mu, double sigma);
+  private: NoiseStream noise_;
 
   /// \brief A pointer to the Gazebo joint
   private: physics::JointPtr joint_;
@@ -19,6 +19,7 @@
 #define GAZEBO_ROS_LASER_HH
 
 #include <string>
+#include <vector>
 
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
@@ -26,6 +27,7 @@
 #include <ros/ros.h>
 #include <ros/advertise_options.h>
 #include <sensor_msgs/LaserScan.h>
+#include <sensor_msgs/PointCloud2.h>
 
 #include <gazebo/physics/physics.hh>
 #include <gazebo/transport/TransportTypes.hh>
@@ -38,7 +40,10 @@
 
 #include <sdf/sdf.hh>
 
+#include <gazebo_plugins/LaserRayTables.h>
+#include <gazebo_plugins/MessagePool.h>
 #include <gazebo_plugins/PubQueue.h>
+#include <gazebo_plugins/PointCloud2Layout.h>
 
 namespace gazebo
 {
@@ -70,6 +75,9 @@ namespace gazebo
     private: ros::Publisher pub_;
     private: PubQueue<sensor_msgs::LaserScan>::Ptr pub_queue_;
 
+    /// \brief Pool of LaserScan messages handed to the publisher queue
+    private: MessagePool<sensor_msgs::LaserScan> scan_pool_;
+
     /// \brief topic name
     private: std::string topic_name_;
 
@@ -91,6 +99,23 @@ namespace gazebo
     private: gazebo::transport::SubscriberPtr laser_scan_sub_;
     private: void OnScan(ConstLaserScanStampedPtr &_msg);
 
+    /// \brief Convert a multi-ring scan into a PointCloud2 and publish it
+    private: void PublishPointCloud2(ConstLaserScanStampedPtr &_msg);
+
+    /// \brief Publish a PointCloud2 of all vertical rays instead of a
+    /// LaserScan
+    private: bool output_point_cloud2_;
+
+    /// \brief Fields of the PointCloud2 output
+    private: PointCloud2Layout cloud2_layout_;
+
+    /// \brief Pool of PointCloud2 messages handed to the publisher queue
+    private: MessagePool<sensor_msgs::PointCloud2> cloud2_pool_;
+    private: PubQueue<sensor_msgs::PointCloud2>::Ptr cloud2_pub_queue_;
+
+    /// \brief Ray directions of the scans
+    private: LaserRayTables ray_tables_;
+
     /// \brief prevents blocking
     private: PubMultiQueue pmq;
   };
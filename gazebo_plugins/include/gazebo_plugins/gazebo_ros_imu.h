@@ -32,6 +32,7 @@
 #include <gazebo/transport/transport.hh>
 #include <gazebo/common/common.hh>
 
+#include <gazebo_plugins/NoiseStream.h>
 #include <gazebo_plugins/PubQueue.h>
 
 namespace gazebo
@@ -98,7 +99,7 @@ namespace gazebo
     private: double gaussian_noise_;
 
     /// \brief Gaussian noise generator
-    private: double GaussianKernel(double mu, double sigma);
+    private: NoiseStream noise_;
 
     /// \brief for setting ROS name space
     private: std::string robot_namespace_;
@@ -25,6 +25,8 @@
 #include <sensor_msgs/Imu.h>
 #include <string>
 
+#include <gazebo_plugins/NoiseStream.h>
+
 namespace gazebo
 {
   namespace sensors
@@ -59,9 +61,7 @@ namespace gazebo
     /// \brief Load the parameters from the sdf file.
     bool LoadParameters();
     /// \brief Gaussian noise generator.
-    /// \param mu offset value.
-    /// \param sigma scaling value.
-    double GuassianKernel(double mu, double sigma);
+    NoiseStream noise;
     
     /// \brief Ros NodeHandle pointer.
     ros::NodeHandle* node;
@@ -30,7 +30,12 @@
 #ifndef JOINT_STATE_PUBLISHER_PLUGIN_HH
 #define JOINT_STATE_PUBLISHER_PLUGIN_HH
 
+#include <boost/atomic.hpp>
 #include <boost/bind.hpp>
+#include <boost/lockfree/spsc_queue.hpp>
+#include <boost/scoped_ptr.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
 #include <gazebo/gazebo.hh>
 #include <gazebo/physics/physics.hh>
 #include <gazebo/common/common.hh>
@@ -47,31 +52,69 @@
 // 		<robotNamespace>/pioneer2dx</robotNamespace>
 // 		<jointName>chassis_swivel_joint, swivel_wheel_joint, left_hub_joint, right_hub_joint</jointName>
 // 		<updateRate>100.0</updateRate>
+// 		<queueSize>16</queueSize>
 // 		<alwaysOn>true</alwaysOn>
 //       </plugin>
 //   </gazebo>
+//
+// Every axis of a joint is published, the first one under the joint name and
+// the others as <joint>_<axis>, e.g. ball_joint, ball_joint_1, ball_joint_2.
+// Messages are stamped with the simulation time.  The physics thread only
+// copies the joint states into one of <queueSize> preallocated messages and
+// hands it to the publisher thread through a lock-free queue; when all of
+// them are still waiting to be published the state is dropped.
 
 
 
 namespace gazebo {
+// Joint states shared with the other plugins of the model, defined in
+// <gazebo_ros/joint_state_cache.h>
+class JointStateCache;
+typedef boost::shared_ptr<JointStateCache> JointStateCachePtr;
+
 class GazeboRosJointStatePublisher : public ModelPlugin {
 public:
     GazeboRosJointStatePublisher();
     ~GazeboRosJointStatePublisher();
     void Load ( physics::ModelPtr _parent, sdf::ElementPtr _sdf );
     void OnUpdate ( const common::UpdateInfo & _info );
-    void publishJointStates();
+    void publishJointStates ( const common::Time &_stamp );
     // Pointer to the model
 private:
+    /// \brief Publishes the states handed over by publishJointStates
+    void publisherThread();
+
     event::ConnectionPtr updateConnection;
     physics::WorldPtr world_;
     physics::ModelPtr parent_;
     std::vector<physics::JointPtr> joints_;
 
+    /// \brief Joint states shared with the other plugins of the model, and
+    /// the cache index of each entry of the message
+    JointStateCachePtr joint_state_cache_;
+    std::vector<unsigned int> cache_indices_;
+
     // ROS STUFF
     boost::shared_ptr<ros::NodeHandle> rosnode_;
-    sensor_msgs::JointState joint_state_;
     ros::Publisher joint_state_publisher_;
+
+    /// \brief Preallocated messages, names are filled once at load
+    std::vector<sensor_msgs::JointState> joint_states_;
+
+    /// \brief Indices of the messages free to fill and ready to publish,
+    /// the physics thread is the only producer of ready_ and consumer of
+    /// free_, the publisher thread the other way round
+    boost::scoped_ptr<boost::lockfree::spsc_queue<unsigned int> > free_;
+    boost::scoped_ptr<boost::lockfree::spsc_queue<unsigned int> > ready_;
+
+    boost::thread publisher_thread_;
+    boost::atomic<bool> publishing_;
+    boost::mutex publisher_mutex_;
+    boost::condition_variable publisher_cond_;
+
+    /// \brief States dropped because no message was free
+    unsigned int dropped_;
+
     std::string tf_prefix_;
     std::string robot_namespace_;
     std::vector<std::string> joint_names_;
@@ -19,6 +19,7 @@
 #define GAZEBO_ROS_LASER_HH
 
 #include <string>
+#include <vector>
 
 #include <boost/bind.hpp>
 #include <boost/thread.hpp>
@@ -26,6 +27,7 @@
 #include <ros/ros.h>
 #include <ros/advertise_options.h>
 #include <sensor_msgs/LaserScan.h>
+#include <sensor_msgs/PointCloud2.h>
 
 #include <sdf/Param.hh>
 #include <gazebo/physics/physics.hh>
@@ -38,6 +40,9 @@
 #include <gazebo/plugins/RayPlugin.hh>
 #include <gazebo_plugins/gazebo_ros_utils.h>
 
+#include <gazebo_plugins/LaserRayTables.h>
+#include <gazebo_plugins/MessagePool.h>
+#include <gazebo_plugins/PointCloud2Layout.h>
 #include <gazebo_plugins/PubQueue.h>
 
 namespace gazebo
@@ -71,6 +76,9 @@ namespace gazebo
     private: ros::Publisher pub_;
     private: PubQueue<sensor_msgs::LaserScan>::Ptr pub_queue_;
 
+    /// \brief Pool of LaserScan messages handed to the publisher queue
+    private: MessagePool<sensor_msgs::LaserScan> scan_pool_;
+
     /// \brief topic name
     private: std::string topic_name_;
 
@@ -92,6 +100,65 @@ namespace gazebo
     private: gazebo::transport::SubscriberPtr laser_scan_sub_;
     private: void OnScan(ConstLaserScanStampedPtr &_msg);
 
+    /// \brief Project a scan into the fixed frame and add it to the ring
+    /// of assembled scans
+    private: void AssembleScan(ConstLaserScanStampedPtr &_msg);
+
+    /// \brief Publish the ring of assembled scans as one PointCloud2
+    private: void PublishAssembledCloud(const ros::Time &_stamp);
+
+    /// \brief Topic of the assembled cloud, empty if disabled
+    private: std::string assembled_topic_name_;
+
+    /// \brief Frame of the assembled cloud, its points are in Gazebo world
+    /// coordinates
+    private: std::string assembled_frame_name_;
+
+    /// \brief Publisher and pooled messages of the assembled cloud
+    private: ros::Publisher assembled_pub_;
+    private: PubQueue<sensor_msgs::PointCloud2>::Ptr assembled_pub_queue_;
+    private: MessagePool<sensor_msgs::PointCloud2> assembled_pool_;
+
+    /// \brief Ring of the last scans, x, y, z and intensity of each valid
+    /// ray in the fixed frame
+    private: std::vector<std::vector<float> > assembled_scans_;
+    private: size_t assembled_next_;
+
+    /// \brief Publish period of the assembled cloud
+    private: double assembled_period_;
+    private: ros::Time last_assembled_time_;
+
+    /// \brief Publish the scan as a PointCloud2 distorted like the scan of
+    /// a rotating sensor, with per-point time offsets
+    private: void PublishRollingScan(ConstLaserScanStampedPtr &_msg);
+
+    /// \brief Topic of the rolling scan cloud, empty if disabled
+    private: std::string rolling_topic_name_;
+
+    /// \brief Publisher and pooled messages of the rolling scan cloud
+    private: ros::Publisher rolling_pub_;
+    private: PubQueue<sensor_msgs::PointCloud2>::Ptr rolling_pub_queue_;
+    private: MessagePool<sensor_msgs::PointCloud2> rolling_pool_;
+
+    /// \brief Fields of the rolling scan cloud
+    private: PointCloud2Layout rolling_layout_;
+
+    /// \brief Sensor pose and time of the previous scan, the start of the
+    /// sweep of the current one
+    private: ignition::math::Pose3d rolling_last_pose_;
+    private: ros::Time rolling_last_time_;
+    private: bool rolling_has_last_;
+
+    /// \brief Longest sweep, scans further apart are not distorted
+    private: double rolling_max_period_;
+
+    /// \brief Per column share of the sweep still ahead of the ray, and
+    /// cosine and sine of the rotation over that share
+    private: std::vector<float> rolling_share_, rolling_cos_, rolling_sin_;
+
+    /// \brief Ray directions of the scans
+    private: LaserRayTables ray_tables_;
+
     /// \brief prevents blocking
     private: PubMultiQueue pmq;
   };
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/*
+ * Desc: Model contacts plugin, publishes the contacts of all links of a
+ *       model from a single plugin instance.
+ */
+
+#ifndef GAZEBO_ROS_MODEL_CONTACTS_HH
+#define GAZEBO_ROS_MODEL_CONTACTS_HH
+
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <ros/ros.h>
+#include <gazebo_msgs/ModelContacts.h>
+
+#include <gazebo/physics/physics.hh>
+#include <gazebo/common/Time.hh>
+#include <gazebo/common/Plugin.hh>
+#include <gazebo/msgs/msgs.hh>
+#include <gazebo/transport/TransportTypes.hh>
+
+#include <gazebo_plugins/MessagePool.h>
+#include <gazebo_plugins/PubQueue.h>
+
+namespace gazebo
+{
+  /// \brief Publishes the contacts of all links of a model as one
+  /// gazebo_msgs/ModelContacts per physics step, without a contact sensor
+  /// and a GazeboRosBumper per link.
+  ///
+  /// The plugin creates one filter on the contact manager for the
+  /// collisions of the model and subscribes to it while <topicName> has
+  /// subscribers.  Contacts are grouped by link through a hash index from
+  /// collision to link.  A contact between two links of the model is
+  /// reported once, under the link of collision1.  A link that is
+  /// collision2 of a contact with another model is reported as collision1
+  /// with the wrench on its body and the normal reversed.  Every
+  /// ContactState is filled like gazebo_ros_bumper does, in world frame.
+  ///
+  /// \verbatim
+  ///   <plugin name="contacts" filename="libgazebo_ros_model_contacts.so">
+  ///     <robotNamespace>robot</robotNamespace>
+  ///     <topicName>contacts</topicName>
+  ///     <frameName>world</frameName>
+  ///     <linkNames>l_foot r_foot l_hand r_hand</linkNames>
+  ///     <outputMode>aggregated</outputMode>  <!-- or raw -->
+  ///     <updateRate>100</updateRate>
+  ///   </plugin>
+  /// \endverbatim
+  /// Without <linkNames> all links of the model are used.  Without
+  /// <updateRate> every physics step is published.
+  class GazeboRosModelContacts : public ModelPlugin
+  {
+    /// \brief Constructor
+    public: GazeboRosModelContacts();
+
+    /// \brief Destructor
+    public: virtual ~GazeboRosModelContacts();
+
+    /// \brief Load the plugin
+    /// \param take in SDF root element
+    public: void Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf);
+
+    /// \brief Subscribe to the contacts on the first ROS subscriber
+    private: void ContactsConnect();
+
+    /// \brief Unsubscribe from the contacts after the last ROS subscriber
+    private: void ContactsDisconnect();
+
+    /// \brief Group the contacts of a physics step by link and publish them
+    private: void OnContacts(ConstContactsPtr &_msg);
+
+    private: physics::WorldPtr world_;
+    private: physics::ModelPtr model_;
+
+    /// \brief Links reported by the plugin, indexed by bucket
+    private: std::vector<std::string> link_names_;
+
+    /// \brief Bucket of each collision of the reported links, by scoped name
+    private: std::unordered_map<std::string, unsigned int> collision_links_;
+
+    /// \brief Indices of the contacts of each link in the current message,
+    /// and whether the link is collision2 of the contact, reused across steps
+    private: std::vector<std::vector<std::pair<int, bool> > > buckets_;
+
+    /// \brief Name of the contact manager filter
+    private: std::string filter_name_;
+
+    /// \brief Gazebo topic of the contact manager filter
+    private: std::string contacts_topic_;
+
+    private: transport::NodePtr gazebo_node_;
+    private: transport::SubscriberPtr contacts_sub_;
+    private: int connect_count_;
+
+    /// \brief pointer to ros node
+    private: ros::NodeHandle* rosnode_;
+    private: ros::Publisher pub_;
+    private: PubQueue<gazebo_msgs::ModelContacts>::Ptr pub_queue_;
+
+    /// \brief Reused messages, the latest one may still be in the
+    /// publisher queue
+    private: MessagePool<gazebo_msgs::ModelContacts> msg_pool_;
+
+    /// \brief topic name
+    private: std::string topic_name_;
+
+    /// \brief frame of the published contacts
+    private: std::string frame_name_;
+
+    /// \brief One reading per collision pair instead of every point
+    private: bool aggregated_;
+
+    /// \brief for setting ROS name space
+    private: std::string robot_namespace_;
+
+    /// update rate of this plugin
+    private: double update_period_;
+    private: common::Time last_update_time_;
+
+    // ros publish multi queue, prevents publish() blocking
+    private: PubMultiQueue pmq;
+  };
+}
+#endif
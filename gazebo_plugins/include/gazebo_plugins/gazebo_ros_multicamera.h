@@ -21,6 +21,9 @@
 #include <string>
 #include <vector>
 
+#include <ros/ros.h>
+#include <gazebo_msgs/MultiCameraFrame.h>
+
 // library for processing camera data for gazebo / ros conversions
 #include <gazebo_plugins/gazebo_ros_camera_utils.h>
 #include <gazebo_plugins/MultiCameraPlugin.h>
@@ -59,6 +62,35 @@ namespace gazebo
     private: boost::shared_ptr<int> image_connect_count_;
     private: boost::shared_ptr<boost::mutex> image_connect_count_lock_;
     private: boost::shared_ptr<bool> was_active_;
+
+    /// \brief Copy a frame into the bundle and publish the bundle once every
+    /// camera has delivered an image for the same measurement time.
+    /// \param[in] _image Raw image data of the camera.
+    /// \param[in] _index Index of the camera in utils.
+    /// \param[in] _stamp Measurement time of the frame.
+    private: void BundleFrame(const unsigned char *_image, unsigned int _index,
+                 const common::Time &_stamp);
+
+    /// \brief Keep track of number of bundle connections
+    private: void BundleConnect();
+    private: void BundleDisconnect();
+
+    /// \brief Optional output publishing all camera images in one message.
+    /// Enabled by setting <bundleTopicName>.
+    private: boost::shared_ptr<ros::NodeHandle> bundle_rosnode_;
+    private: ros::Publisher bundle_pub_;
+    private: int bundle_connect_count_;
+
+    /// \brief Bundle message, reused across frames so image buffers keep
+    /// their capacity.
+    private: gazebo_msgs::MultiCameraFrame bundle_msg_;
+    private: std::vector<bool> bundle_received_;
+    private: unsigned int bundle_pending_;
+    private: common::Time bundle_stamp_;
+
+    /// \brief Protects bundle_connect_count_, changed from ROS callback
+    /// threads, and the bundle message.
+    private: boost::mutex bundle_lock_;
   };
 }
 #endif
@@ -111,9 +111,9 @@ namespace gazebo
     private: ros::Publisher point_cloud_pub_;
     private: ros::Publisher depth_image_pub_;
 
-    /// \brief PointCloud2 point cloud message
-    private: sensor_msgs::PointCloud2 point_cloud_msg_;
-    private: sensor_msgs::Image depth_image_msg_;
+    /// \brief Pools of PointCloud2 point cloud and depth image messages
+    private: MessagePool<sensor_msgs::PointCloud2> point_cloud_pool_;
+    private: MessagePool<sensor_msgs::Image> depth_image_pool_;
 
     /// \brief Minimum range of the point cloud
     private: double point_cloud_cutoff_;
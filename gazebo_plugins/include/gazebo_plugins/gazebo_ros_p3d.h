@@ -41,6 +41,7 @@
 #include <gazebo/common/Plugin.hh>
 #include <gazebo/common/Events.hh>
 
+#include <gazebo_plugins/NoiseStream.h>
 #include <gazebo_plugins/PubQueue.h>
 
 namespace gazebo
@@ -112,7 +113,7 @@ namespace gazebo
     private: double gaussian_noise_;
 
     /// \brief Gaussian noise generator
-    private: double GaussianKernel(double mu, double sigma);
+    private: NoiseStream noise_;
 
     /// \brief for setting ROS name space
     private: std::string robot_namespace_;
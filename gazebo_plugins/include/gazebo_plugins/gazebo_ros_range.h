@@ -60,6 +60,8 @@
 
 #include <sdf/Param.hh>
 
+#include <gazebo_plugins/NoiseStream.h>
+
 namespace gazebo
 {
 
@@ -115,7 +117,7 @@ class GazeboRosRange : public RayPlugin
     private: double gaussian_noise_;
 
     /// \brief Gaussian noise generator
-    private: double GaussianKernel(double mu, double sigma);
+    private: NoiseStream noise_;
 
     /// \brief mutex to lock access to fields that are used in message callbacks
     private: boost::mutex lock_;
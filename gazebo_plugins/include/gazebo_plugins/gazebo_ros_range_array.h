@@ -0,0 +1,169 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/*
+ * Desc: Range array plugin, publishes all ray sensors of a sonar ring
+ *       from a single plugin instance.
+ */
+
+#ifndef GAZEBO_ROS_RANGE_ARRAY_HH
+#define GAZEBO_ROS_RANGE_ARRAY_HH
+
+#include <string>
+#include <vector>
+
+#include <ros/ros.h>
+#include <sensor_msgs/Range.h>
+#include <gazebo_msgs/RangeArray.h>
+
+#include <gazebo/physics/physics.hh>
+#include <gazebo/common/Time.hh>
+#include <gazebo/common/Plugin.hh>
+#include <gazebo/common/Events.hh>
+#include <gazebo/sensors/SensorTypes.hh>
+
+#include <gazebo_plugins/NoiseStream.h>
+#include <gazebo_plugins/PubQueue.h>
+
+namespace gazebo
+{
+  /// \brief Publishes the readings of many ray sensors of one model, e.g. a
+  /// ring of 16 to 24 sonars, with one node handle and one publisher thread
+  /// instead of one GazeboRosRange instance per sensor.
+  ///
+  /// Every sensor is reduced to the minimum range of its rays, like
+  /// GazeboRosRange.  Only new scans of the sensors are published, the
+  /// array once every sensor produced a scan.  The readings are published
+  /// either as one
+  /// gazebo_msgs/RangeArray on <topicName>, or as one sensor_msgs/Range per
+  /// sensor on <topicName>/<sensor name>.
+  ///
+  /// \verbatim
+  ///   <plugin name="sonar_ring" filename="libgazebo_ros_range_array.so">
+  ///     <robotNamespace>robot</robotNamespace>
+  ///     <topicName>sonar</topicName>
+  ///     <outputType>RangeArray</outputType>  <!-- or Range -->
+  ///     <sensorNames>sonar_0 sonar_1 sonar_2</sensorNames>
+  ///     <updateRate>10</updateRate>
+  ///     <radiation>ultrasound</radiation>
+  ///     <fov>0.5</fov>
+  ///     <gaussianNoise>0.005</gaussianNoise>
+  ///   </plugin>
+  /// \endverbatim
+  /// Without <sensorNames> all ray sensors of the model are used, in link
+  /// order.  The frame of each reading is the link of its sensor.
+  class GazeboRosRangeArray : public ModelPlugin
+  {
+    /// \brief Constructor
+    public: GazeboRosRangeArray();
+
+    /// \brief Destructor
+    public: virtual ~GazeboRosRangeArray();
+
+    /// \brief Load the plugin
+    /// \param take in SDF root element
+    public: void Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf);
+
+    /// \brief Update the plugin
+    protected: virtual void UpdateChild();
+
+    /// \brief Look up the ray sensors, which may be created after the
+    /// model plugins are loaded.
+    /// \return True once all sensors were found
+    private: bool FindSensors();
+
+    /// \brief Read all sensors and publish their ranges
+    private: void PutRangeData();
+
+    /// \brief One ray sensor of the array
+    private: struct RangeSensor
+    {
+      /// \brief Scoped name of the sensor
+      std::string scoped_name;
+      /// \brief The ray sensor, NULL until it has been created
+      sensors::RaySensorPtr sensor;
+      /// \brief Publisher of the individual Range output
+      ros::Publisher pub;
+      /// \brief Noise stream of this sensor
+      NoiseStream noise;
+      /// \brief Measurement time of the last reading taken from the sensor
+      common::Time last_measurement_time;
+      /// \brief True once the sensor produced its first scan
+      bool measured;
+    };
+
+    private: physics::WorldPtr world_;
+    private: physics::ModelPtr model_;
+
+    /// \brief The sensors, in the order of the published array
+    private: std::vector<RangeSensor> sensors_;
+    private: bool sensors_found_;
+
+    /// \brief Rays of the sensor being read, reused across sensors
+    private: std::vector<double> ray_ranges_;
+
+    /// \brief pointer to ros node
+    private: ros::NodeHandle* rosnode_;
+    private: ros::Publisher pub_;
+    private: PubQueue<gazebo_msgs::RangeArray>::Ptr array_pub_queue_;
+    private: PubQueue<sensor_msgs::Range>::Ptr range_pub_queue_;
+
+    /// \brief ros message, its ranges double as templates for the
+    /// individual Range output
+    private: gazebo_msgs::RangeArray array_msg_;
+
+    /// \brief topic name of the array, or namespace of the Range topics
+    private: std::string topic_name_;
+
+    /// \brief Publish one Range per sensor instead of a RangeArray
+    private: bool output_individual_;
+
+    /// \brief radiation type : ultrasound or infrared
+    private: std::string radiation_;
+
+    /// \brief sensor field of view
+    private: double fov_;
+
+    /// \brief Gaussian noise
+    private: double gaussian_noise_;
+
+    /// \brief tf prefix
+    private: std::string tf_prefix_;
+
+    /// \brief for setting ROS name space
+    private: std::string robot_namespace_;
+
+    /// \brief Names of the sensors given in <sensorNames>
+    private: std::vector<std::string> sensor_names_;
+
+    private: sdf::ElementPtr sdf;
+
+    /// update rate of this plugin
+    private: double update_period_;
+    private: common::Time last_update_time_;
+
+    /// \brief True while the sensors are switched on for the subscribers
+    private: bool sensors_active_;
+
+    // Pointer to the update event connection
+    private: event::ConnectionPtr update_connection_;
+
+    // ros publish multi queue, the only thread of this plugin
+    private: PubMultiQueue pmq;
+  };
+}
+#endif
@@ -18,8 +18,11 @@
 #ifndef GAZEBO_ROS_TRIGGERED_CAMERA_HH
 #define GAZEBO_ROS_TRIGGERED_CAMERA_HH
 
+#include <functional>
+#include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 // library for processing camera data for gazebo / ros conversions
 #include <gazebo/plugins/CameraPlugin.hh>
@@ -64,14 +67,62 @@ namespace gazebo
 
     public: void SetCameraEnabled(const bool _enabled);
 
+    /// \brief Trigger the camera and enable it right away, so that it
+    /// renders in the upcoming render pass.
+    public: void TriggerAndEnable();
+
+    /// \brief Name of the rendering camera
+    public: std::string CameraName() const;
+
     protected: void PreRender();
 
     protected: int triggered = 0;
 
     protected: std::mutex mutex;
 
+    /// \brief Group this camera is triggered with, see <triggerGroup>
+    protected: std::string trigger_group_;
+
+    /// \brief Read <triggerGroup> and register with the camera groups
+    private: void LoadTriggerGroup(sdf::ElementPtr _sdf);
+
     friend class GazeboRosTriggeredMultiCamera;
   };
+
+  /// \brief Process-wide index of triggered cameras by their <triggerGroup>,
+  /// used by GazeboRosCameraTriggerBroker to trigger a whole group at once.
+  class GazeboRosTriggeredCameraGroups
+  {
+    public: static GazeboRosTriggeredCameraGroups &Instance();
+
+    /// \brief Add a camera to a group
+    public: void Add(const std::string &_group,
+                GazeboRosTriggeredCamera *_camera);
+
+    /// \brief Remove a camera from all groups
+    public: void Remove(GazeboRosTriggeredCamera *_camera);
+
+    /// \brief Trigger and enable every camera of a group, so that all of
+    /// them render in the same pass.
+    /// \return Names of the triggered cameras
+    public: std::vector<std::string> Trigger(const std::string &_group);
+
+    /// \brief Notify listeners that a grouped camera published a frame
+    public: void Published(const std::string &_group,
+                const std::string &_camera);
+
+    /// \brief Connect to frames published by grouped cameras. The callback
+    /// receives the group and camera name.
+    public: event::ConnectionPtr ConnectPublished(
+                std::function<void(const std::string &,
+                const std::string &)> _subscriber);
+
+    private: std::mutex mutex;
+    private: std::map<std::string,
+                 std::vector<GazeboRosTriggeredCamera *> > groups;
+    private: event::EventT<void(const std::string &,
+                 const std::string &)> published;
+  };
 }
 #endif
 
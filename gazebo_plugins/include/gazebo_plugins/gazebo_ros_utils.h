@@ -40,8 +40,11 @@
 #include <gazebo/physics/physics.hh>
 #include <gazebo/sensors/Sensor.hh>
 #include <gazebo/gazebo_config.h>
+#include <ignition/math/Rand.hh>
 #include <ros/ros.h>
 
+#include <gazebo_plugins/NoiseStream.h>
+
 #ifndef GAZEBO_SENSORS_USING_DYNAMIC_POINTER_CAST
 # if GAZEBO_MAJOR_VERSION >= 7
 #define GAZEBO_SENSORS_USING_DYNAMIC_POINTER_CAST using std::dynamic_pointer_cast
@@ -101,6 +104,29 @@ inline std::string GetRobotNamespace ( const sensors::SensorPtr &parent, const s
     return name_space;
 }
 
+/**
+* @brief Seeds the noise stream of a plugin for deterministic replay.
+* The seed is read from the optional <noiseSeed> tag and defaults to the
+* Gazebo seed (gazebo --seed), the stream is derived from the scoped name
+* of the sensor, so two runs with the same seed produce identical noise
+* regardless of load order and of how sensors are spread over threads.
+* @param stream noise stream to seed
+* @param sdf sdf of the plugin
+* @param scoped_name scoped name of the sensor, link or joint
+* @param pInfo
+**/
+inline void SeedNoiseStream ( NoiseStream &stream, const sdf::ElementPtr &sdf, const std::string &scoped_name, const char *pInfo = NULL )
+{
+    uint64_t seed = ignition::math::Rand::Seed();
+    if ( sdf->HasElement ( "noiseSeed" ) ) {
+        seed = sdf->Get<unsigned int> ( "noiseSeed" );
+    }
+    stream.seed ( seed, NoiseStream::hashName ( scoped_name ) );
+    if ( pInfo != NULL ) {
+        ROS_DEBUG_NAMED("utils", "%s Plugin: noise seed %lu, stream '%s'", pInfo, static_cast<unsigned long> ( seed ), scoped_name.c_str() );
+    }
+}
+
 /**
  * Gazebo ros helper class
  * The class simplifies the parameter and rosnode handling
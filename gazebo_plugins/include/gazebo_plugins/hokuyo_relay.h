@@ -0,0 +1,118 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#ifndef HOKUYO_RELAY_HH
+#define HOKUYO_RELAY_HH
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <ros/ros.h>
+#include <sensor_msgs/LaserScan.h>
+#include <dynamic_reconfigure/server.h>
+#include <nodelet/nodelet.h>
+
+#include <gazebo_plugins/HokuyoConfig.h>
+#include <gazebo_plugins/MessagePool.h>
+
+namespace gazebo_plugins
+{
+  /// \brief Stand-in for the hokuyo_node driver on a simulated laser.
+  ///
+  /// Subscribes to the scan of a gazebo_ros_laser or gazebo_ros_gpu_laser
+  /// plugin on scan_in and republishes it on scan reduced like the real
+  /// driver would, using the Hokuyo dynamic reconfigure parameters:
+  /// - min_ang, max_ang: angular window of the published scan
+  /// - cluster: number of adjacent rays merged into one reading, keeping
+  ///   the closest valid range
+  /// - skip: number of scans dropped between published scans
+  /// - intensity: whether intensities are published
+  /// - frame_id, time_offset: frame and stamp offset of the published scan
+  /// The device parameters (port, calibrate_time, allow_unsafe_settings)
+  /// are accepted and ignored.
+  ///
+  /// Run in the same nodelet manager as the consumers, scans are passed by
+  /// pointer, and scans that need no reduction are forwarded unchanged.
+  /// The input is only subscribed while the output has subscribers.
+  class HokuyoRelay
+  {
+    /// \brief Constructor
+    /// \param[in] nh Node handle of the scan_in and scan topics
+    /// \param[in] private_nh Node handle of the reconfigure parameters
+    public: HokuyoRelay(ros::NodeHandle nh, ros::NodeHandle private_nh);
+
+    /// \brief Reduce a scan to the window, clusters and fields given by
+    /// config.  Output messages may be reused, every field is overwritten.
+    /// \param[in] in The full scan
+    /// \param[in] config Reconfigure parameters
+    /// \param[out] out The reduced scan
+    /// \return False if the window holds no ray of the scan
+    public: static bool FilterScan(const sensor_msgs::LaserScan &in,
+                                   const HokuyoConfig &config,
+                                   sensor_msgs::LaserScan &out);
+
+    /// \brief Whether FilterScan would leave the scan as it is
+    public: static bool IsPassThrough(const sensor_msgs::LaserScan &in,
+                                      const HokuyoConfig &config);
+
+    /// \brief Dynamic reconfigure callback
+    private: void ReconfigureCallback(HokuyoConfig &config, uint32_t level);
+
+    /// \brief Reduce and republish a scan
+    private: void OnScan(const sensor_msgs::LaserScan::ConstPtr &scan);
+
+    /// \brief Subscribe to the input once the output is subscribed
+    private: void ScanConnect();
+
+    /// \brief Unsubscribe from the input once the output is unsubscribed
+    private: void ScanDisconnect();
+
+    private: ros::NodeHandle nh_;
+    private: ros::Subscriber sub_;
+    private: ros::Publisher pub_;
+
+    /// \brief Parameters currently applied, protected by lock_
+    private: HokuyoConfig config_;
+
+    /// \brief Scans received since the last published one
+    private: int skipped_;
+
+    /// \brief Protects the configuration
+    private: boost::mutex lock_;
+
+    /// \brief Protects the subscription, separate from lock_ as
+    /// unsubscribing waits for a running OnScan
+    private: boost::mutex connect_lock_;
+
+    /// \brief Reused output scans
+    private: MessagePool<sensor_msgs::LaserScan> scan_pool_;
+
+    private: boost::shared_ptr<
+      dynamic_reconfigure::Server<HokuyoConfig> > srv_;
+  };
+
+  /// \brief Nodelet running a HokuyoRelay
+  class HokuyoNodelet : public nodelet::Nodelet
+  {
+    /// \brief Create the relay on the nodelet node handles
+    private: virtual void onInit();
+
+    private: boost::shared_ptr<HokuyoRelay> relay_;
+  };
+}
+
+#endif
@@ -1,6 +1,7 @@
 #!/usr/bin/env python
 import rospy
 from sensor_msgs.msg import Range
+from gazebo_msgs.msg import RangeArray
 
 import unittest
 
@@ -14,6 +15,13 @@ class TestRangePlugin(unittest.TestCase):
     msg = rospy.wait_for_message('/sonar', Range)
     self.assertTrue(msg.range < 0.25 and msg.range > 0.22, 'actual value: {0}'.format(msg.range))
 
+  def test_range_array(self):
+    msg = rospy.wait_for_message('/sonar_array', RangeArray)
+    self.assertEqual(len(msg.ranges), 1)
+    self.assertEqual(msg.ranges[0].header.frame_id, 'link_1')
+    self.assertTrue(msg.ranges[0].range < 0.25 and msg.ranges[0].range > 0.22,
+                    'actual value: {0}'.format(msg.ranges[0].range))
+
 if __name__ == '__main__':
   import rostest
   PKG_NAME = 'gazebo_plugins'
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <assert.h>
+#include <cmath>
 #include <limits>
 
 #include <gazebo_plugins/gazebo_ros_block_laser.h>
@@ -57,6 +58,8 @@ GZ_REGISTER_SENSOR_PLUGIN(GazeboRosBlockLaser)
 // Constructor
 GazeboRosBlockLaser::GazeboRosBlockLaser()
 {
+  this->horizontal_table_.rays = 0;
+  this->vertical_table_.rays = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -122,6 +125,34 @@ void GazeboRosBlockLaser::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->topic_name_ = _sdf->GetElement("topicName")->Get<std::string>();
 
+  this->output_point_cloud2_ = false;
+  if (_sdf->HasElement("outputType"))
+  {
+    std::string output_type = _sdf->GetElement("outputType")->Get<std::string>();
+    if (output_type == "PointCloud2")
+      this->output_point_cloud2_ = true;
+    else if (output_type != "PointCloud")
+      ROS_WARN_NAMED("block_laser", "Block laser plugin <outputType> [%s] unknown,"
+        " use PointCloud or PointCloud2. Defaults to PointCloud", output_type.c_str());
+  }
+
+  if (_sdf->HasElement("pointCloud2Fields"))
+  {
+    std::string spec = _sdf->GetElement("pointCloud2Fields")->Get<std::string>();
+    unsigned int fields;
+    if (PointCloud2Layout::parseFields(spec, fields))
+    {
+      // the simulated scan is instantaneous, every ray would get time 0
+      if (fields & PointCloud2Layout::TIME)
+        ROS_WARN_NAMED("block_laser", "Block laser plugin <pointCloud2Fields> time is only written"
+          " by rolling scans, ignored");
+      this->cloud2_layout_.setFields(fields & ~PointCloud2Layout::TIME);
+    }
+    else
+      ROS_WARN_NAMED("block_laser", "Block laser plugin <pointCloud2Fields> [%s] invalid,"
+        " use any of xyz, intensity, ring. Defaults to xyz intensity", spec.c_str());
+  }
+
   if (!_sdf->HasElement("gaussianNoise"))
   {
     ROS_INFO_NAMED("block_laser", "Block laser plugin missing <gaussianNoise>, defaults to 0.0");
@@ -130,6 +161,9 @@ void GazeboRosBlockLaser::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->gaussian_noise_ = _sdf->GetElement("gaussianNoise")->Get<double>();
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(this->noise_, _sdf, this->parent_sensor_->ScopedName(), "BlockLaser");
+
   if (!_sdf->HasElement("hokuyoMinIntensity"))
   {
     ROS_INFO_NAMED("block_laser", "Block laser plugin missing <hokuyoMinIntensity>, defaults to 101");
@@ -175,10 +209,21 @@ void GazeboRosBlockLaser::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   if (this->topic_name_ != "")
   {
     // Custom Callback Queue
-    ros::AdvertiseOptions ao = ros::AdvertiseOptions::create<sensor_msgs::PointCloud>(
-      this->topic_name_,1,
-      boost::bind( &GazeboRosBlockLaser::LaserConnect,this),
-      boost::bind( &GazeboRosBlockLaser::LaserDisconnect,this), ros::VoidPtr(), &this->laser_queue_);
+    ros::AdvertiseOptions ao;
+    if (this->output_point_cloud2_)
+    {
+      ao = ros::AdvertiseOptions::create<sensor_msgs::PointCloud2>(
+        this->topic_name_,1,
+        boost::bind( &GazeboRosBlockLaser::LaserConnect,this),
+        boost::bind( &GazeboRosBlockLaser::LaserDisconnect,this), ros::VoidPtr(), &this->laser_queue_);
+    }
+    else
+    {
+      ao = ros::AdvertiseOptions::create<sensor_msgs::PointCloud>(
+        this->topic_name_,1,
+        boost::bind( &GazeboRosBlockLaser::LaserConnect,this),
+        boost::bind( &GazeboRosBlockLaser::LaserDisconnect,this), ros::VoidPtr(), &this->laser_queue_);
+    }
     this->pub_ = this->rosnode_->advertise(ao);
   }
 
@@ -247,13 +292,6 @@ void GazeboRosBlockLaser::OnNewLaserScans()
 // Put laser data to the interface
 void GazeboRosBlockLaser::PutLaserData(common::Time &_updateTime)
 {
-  int i, hja, hjb;
-  int j, vja, vjb;
-  double vb, hb;
-  int    j1, j2, j3, j4; // four corners indices
-  double r1, r2, r3, r4, r; // four corner values + interpolated range
-  double intensity;
-
   this->parent_ray_sensor_->SetActive(false);
 
   auto maxAngle = this->parent_ray_sensor_->AngleMax();
@@ -269,15 +307,22 @@ void GazeboRosBlockLaser::PutLaserData(common::Time &_updateTime)
   auto verticalMaxAngle = this->parent_ray_sensor_->VerticalAngleMax();
   auto verticalMinAngle = this->parent_ray_sensor_->VerticalAngleMin();
 
-  double yDiff = maxAngle.Radian() - minAngle.Radian();
-  double pDiff = verticalMaxAngle.Radian() - verticalMinAngle.Radian();
-
-
-  // set size of cloud message everytime!
-  //int r_size = rangeCount * verticalRangeCount;
-  this->cloud_msg_.points.clear();
-  this->cloud_msg_.channels.clear();
-  this->cloud_msg_.channels.push_back(sensor_msgs::ChannelFloat32());
+  // trig and interpolation indices only change with the ray configuration
+  this->horizontal_table_.update(rayCount, rangeCount,
+    minAngle.Radian(), maxAngle.Radian());
+  this->vertical_table_.update(verticalRayCount, verticalRangeCount,
+    verticalMinAngle.Radian(), verticalMaxAngle.Radian());
+
+  // fetch every ray once instead of once per neighbouring output point
+  physics::MultiRayShapePtr shape = this->parent_ray_sensor_->LaserShape();
+  const int totalRays = rayCount * verticalRayCount;
+  this->ranges_.resize(totalRays);
+  this->retros_.resize(totalRays);
+  for (int k = 0; k < totalRays; k++)
+  {
+    this->ranges_[k] = shape->GetRange(k);
+    this->retros_[k] = shape->GetRetro(k);
+  }
 
   /***************************************************************/
   /*                                                             */
@@ -285,50 +330,63 @@ void GazeboRosBlockLaser::PutLaserData(common::Time &_updateTime)
   /*                                                             */
   /***************************************************************/
   boost::mutex::scoped_lock sclock(this->lock);
-  // Add Frame Name
-  this->cloud_msg_.header.frame_id = this->frame_name_;
-  this->cloud_msg_.header.stamp.sec = _updateTime.sec;
-  this->cloud_msg_.header.stamp.nsec = _updateTime.nsec;
 
-  for (j = 0; j<verticalRangeCount; j++)
+  // points and intensities are overwritten in place, once sized the
+  // message does not allocate again
+  const size_t size = static_cast<size_t>(rangeCount) * verticalRangeCount;
+  if (this->output_point_cloud2_)
   {
-    // interpolating in vertical direction
-    vb = (verticalRangeCount == 1) ? 0 : (double) j * (verticalRayCount - 1) / (verticalRangeCount - 1);
-    vja = (int) floor(vb);
-    vjb = std::min(vja + 1, verticalRayCount - 1);
-    vb = vb - floor(vb); // fraction from min
+    // Add Frame Name
+    this->cloud2_msg_.header.frame_id = this->frame_name_;
+    this->cloud2_msg_.header.stamp.sec = _updateTime.sec;
+    this->cloud2_msg_.header.stamp.nsec = _updateTime.nsec;
+    this->cloud2_layout_.init(this->cloud2_msg_, rangeCount, verticalRangeCount);
+  }
+  else
+  {
+    // Add Frame Name
+    this->cloud_msg_.header.frame_id = this->frame_name_;
+    this->cloud_msg_.header.stamp.sec = _updateTime.sec;
+    this->cloud_msg_.header.stamp.nsec = _updateTime.nsec;
+    this->cloud_msg_.points.resize(size);
+    this->cloud_msg_.channels.resize(1);
+    this->cloud_msg_.channels[0].values.resize(size);
+  }
+
+  const bool noise = this->gaussian_noise_ > 0;
+  const BlockLaserRayTable &h = this->horizontal_table_;
+  const BlockLaserRayTable &v = this->vertical_table_;
+  const double *ranges = &this->ranges_[0];
+  const double *retros = &this->retros_[0];
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  bool dense = true;
 
-    assert(vja >= 0 && vja < verticalRayCount);
-    assert(vjb >= 0 && vjb < verticalRayCount);
+  for (int j = 0; j < verticalRangeCount; j++)
+  {
+    const double cosP = v.cosAngle(j);
+    const double sinP = v.sinAngle(j);
 
-    for (i = 0; i<rangeCount; i++)
+    geometry_msgs::Point32 *points = NULL;
+    float *intensities = NULL;
+    uint8_t *cloud2 = NULL;
+    if (this->output_point_cloud2_)
+    {
+      cloud2 = &this->cloud2_msg_.data[j * this->cloud2_msg_.row_step];
+    }
+    else
     {
-      // Interpolate the range readings from the rays in horizontal direction
-      hb = (rangeCount == 1)? 0 : (double) i * (rayCount - 1) / (rangeCount - 1);
-      hja = (int) floor(hb);
-      hjb = std::min(hja + 1, rayCount - 1);
-      hb = hb - floor(hb); // fraction from min
-
-      assert(hja >= 0 && hja < rayCount);
-      assert(hjb >= 0 && hjb < rayCount);
-
-      // indices of 4 corners
-      j1 = hja + vja * rayCount;
-      j2 = hjb + vja * rayCount;
-      j3 = hja + vjb * rayCount;
-      j4 = hjb + vjb * rayCount;
-      // range readings of 4 corners
-      r1 = this->parent_ray_sensor_->LaserShape()->GetRange(j1);
-      r2 = this->parent_ray_sensor_->LaserShape()->GetRange(j2);
-      r3 = this->parent_ray_sensor_->LaserShape()->GetRange(j3);
-      r4 = this->parent_ray_sensor_->LaserShape()->GetRange(j4);
-
-      // Range is linear interpolation if values are close,
-      // and min if they are very different
-      r = (1-vb)*((1 - hb) * r1 + hb * r2)
-         +   vb *((1 - hb) * r3 + hb * r4);
+      points = &this->cloud_msg_.points[j * rangeCount];
+      intensities = &this->cloud_msg_.channels[0].values[j * rangeCount];
+    }
+
+    for (int i = 0; i < rangeCount; i++)
+    {
+      // Range is linear interpolation of the 4 corners, intensity is averaged
+      double r, retro;
+      BlockLaserRayTable::interpolate(h, v, ranges, retros, i, j, r, retro);
 
       // REP 117 says readings too close to the sensor become -inf, and too far away +inf
+      const bool valid = r >= minRange && r <= maxRange;
       if (r < minRange)
       {
         r = -std::numeric_limits<double>::infinity();
@@ -338,71 +396,58 @@ void GazeboRosBlockLaser::PutLaserData(common::Time &_updateTime)
         r = std::numeric_limits<double>::infinity();
       }
 
-      // Intensity is averaged
-      intensity = 0.25*(this->parent_ray_sensor_->LaserShape()->GetRetro(j1) +
-                        this->parent_ray_sensor_->LaserShape()->GetRetro(j2) +
-                        this->parent_ray_sensor_->LaserShape()->GetRetro(j3) +
-                        this->parent_ray_sensor_->LaserShape()->GetRetro(j4));
-
-      // std::cout << " block debug "
-      //           << "  ij("<<i<<","<<j<<")"
-      //           << "  j1234("<<j1<<","<<j2<<","<<j3<<","<<j4<<")"
-      //           << "  r1234("<<r1<<","<<r2<<","<<r3<<","<<r4<<")"
-      //           << std::endl;
-
-      // get angles of ray to get xyz for point
-      double yAngle = 0.5*(hja+hjb) * yDiff / (rayCount -1) + minAngle.Radian();
-      double pAngle = 0.5*(vja+vjb) * pDiff / (verticalRayCount -1) + verticalMinAngle.Radian();
-
-      /***************************************************************/
-      /*                                                             */
-      /*  point scan from laser                                      */
-      /*                                                             */
-      /***************************************************************/
-      geometry_msgs::Point32 point;
       //pAngle is rotated by yAngle:
-      point.x = r * cos(pAngle) * cos(yAngle);
-      point.y = r * cos(pAngle) * sin(yAngle);
-      point.z = r * sin(pAngle);
+      float x = r * cosP * h.cosAngle(i);
+      float y = r * cosP * h.sinAngle(i);
+      float z = r * sinP;
+      float intensity = retro;
 
-      if (fabs(maxRange - r) > EPSILON_DIFF)
+      if (noise)
       {
-        // add noise to range only if not at max range
-        point.x += this->GaussianKernel(0, this->gaussian_noise_);
-        point.y += this->GaussianKernel(0, this->gaussian_noise_);
-        point.z += this->GaussianKernel(0, this->gaussian_noise_);
+        if (fabs(maxRange - r) > EPSILON_DIFF)
+        {
+          // add noise to range only if not at max range
+          x += this->noise_.gaussian(0, this->gaussian_noise_);
+          y += this->noise_.gaussian(0, this->gaussian_noise_);
+          z += this->noise_.gaussian(0, this->gaussian_noise_);
+        }
+        intensity += this->noise_.gaussian(0, this->gaussian_noise_);
       }
-      this->cloud_msg_.points.push_back(point);
 
-      this->cloud_msg_.channels[0].values.push_back(intensity + this->GaussianKernel(0,this->gaussian_noise_)) ;
+      if (cloud2)
+      {
+        // rays without a return are kept as NaN to keep the cloud organized,
+        // rows start at the lowest vertical ray
+        if (!valid)
+        {
+          x = y = z = nan;
+          dense = false;
+        }
+        this->cloud2_layout_.write(cloud2 + i * this->cloud2_msg_.point_step,
+          x, y, z, intensity, j, 0.0f);
+      }
+      else
+      {
+        points[i].x = x;
+        points[i].y = y;
+        points[i].z = z;
+        intensities[i] = intensity;
+      }
     }
   }
   this->parent_ray_sensor_->SetActive(true);
 
   // send data out via ros message
-  this->pub_.publish(this->cloud_msg_);
-
-
-
+  if (this->output_point_cloud2_)
+  {
+    this->cloud2_msg_.is_dense = dense;
+    this->pub_.publish(this->cloud2_msg_);
+  }
+  else
+    this->pub_.publish(this->cloud_msg_);
 }
 
 
-//////////////////////////////////////////////////////////////////////////////
-// Utility for adding noise
-double GazeboRosBlockLaser::GaussianKernel(double mu,double sigma)
-{
-  // using Box-Muller transform to generate two independent standard normally disbributed normal variables
-  // see wikipedia
-  double U = (double)rand()/(double)RAND_MAX; // normalized uniform random variable
-  double V = (double)rand()/(double)RAND_MAX; // normalized uniform random variable
-  double X = sqrt(-2.0 * ::log(U)) * cos( 2.0*M_PI * V);
-  //double Y = sqrt(-2.0 * ::log(U)) * sin( 2.0*M_PI * V); // the other indep. normal variable
-  // we'll just use X
-  // scale to our mu and sigma
-  X = sigma * X + mu;
-  return X;
-}
-
 // Custom Callback Queue
 ////////////////////////////////////////////////////////////////////////////////
 // custom callback queue thread
@@ -21,7 +21,9 @@
  * Date: 09 Sept. 2008
  */
 
+#include <algorithm>
 #include <map>
+#include <sstream>
 #include <string>
 
 #include <gazebo/physics/World.hh>
@@ -52,7 +54,7 @@ GZ_REGISTER_SENSOR_PLUGIN(GazeboRosBumper)
 
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
-GazeboRosBumper::GazeboRosBumper() : SensorPlugin()
+GazeboRosBumper::GazeboRosBumper() : SensorPlugin(), output_mode_(RAW)
 {
 }
 
@@ -60,6 +62,7 @@ GazeboRosBumper::GazeboRosBumper() : SensorPlugin()
 // Destructor
 GazeboRosBumper::~GazeboRosBumper()
 {
+  this->update_connection_.reset();
   this->rosnode_->shutdown();
   this->callback_queue_thread_.join();
 
@@ -100,6 +103,19 @@ void GazeboRosBumper::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->frame_name_ = _sdf->GetElement("frameName")->Get<std::string>();
 
+  this->output_mode_ = RAW;
+  if (_sdf->HasElement("outputMode"))
+  {
+    std::string output_mode = _sdf->GetElement("outputMode")->Get<std::string>();
+    if (output_mode == "aggregated")
+      this->output_mode_ = AGGREGATED;
+    else if (output_mode == "touch")
+      this->output_mode_ = TOUCH;
+    else if (output_mode != "raw")
+      ROS_WARN_NAMED("bumper", "bumper plugin <outputMode> %s is not raw, "
+        "aggregated or touch, defaults to raw", output_mode.c_str());
+  }
+
   // Make sure the ROS node for Gazebo has already been initialized
   if (!ros::isInitialized())
   {
@@ -115,8 +131,26 @@ void GazeboRosBumper::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   this->rosnode_->getParam(std::string("tf_prefix"), prefix);
   this->frame_name_ = tf::resolve(prefix, this->frame_name_);
 
-  this->contact_pub_ = this->rosnode_->advertise<gazebo_msgs::ContactsState>(
-    std::string(this->bumper_topic_name_), 1);
+  // publish from a separate thread, not from the sensor update
+  this->pmq.startServiceThread();
+  if (this->output_mode_ == TOUCH)
+  {
+    this->contact_pub_ = this->rosnode_->advertise<gazebo_msgs::ContactMask>(
+      std::string(this->bumper_topic_name_), 1);
+    this->contact_mask_pub_queue_ =
+      this->pmq.addPub<gazebo_msgs::ContactMask>();
+
+    this->contact_mask_msg_.header.frame_id = this->frame_name_;
+    for (unsigned int i = 0; i < this->parentSensor->GetCollisionCount(); ++i)
+      this->contact_mask_msg_.collision_names.push_back(
+        this->parentSensor->GetCollisionName(i));
+  }
+  else
+  {
+    this->contact_pub_ = this->rosnode_->advertise<gazebo_msgs::ContactsState>(
+      std::string(this->bumper_topic_name_), 1);
+    this->contact_pub_queue_ = this->pmq.addPub<gazebo_msgs::ContactsState>();
+  }
 
   // Initialize
   // start custom queue for contact bumper
@@ -145,11 +179,32 @@ void GazeboRosBumper::OnContact()
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_BEGIN("fill message");
 #endif
-  msgs::Contacts contacts;
-  contacts = this->parentSensor->Contacts();
+  // the sensor hands out a copy of its contacts, read it in place
+  const msgs::Contacts &contacts = this->parentSensor->Contacts();
+
+  if (this->output_mode_ == TOUCH)
+  {
+    this->contact_mask_msg_.header.stamp = ros::Time(contacts.time().sec(),
+                                 contacts.time().nsec());
+    FillContactMask(contacts, this->contact_mask_msg_);
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    // a few bytes, copied into the queue
+    this->contact_mask_pub_queue_->push(this->contact_mask_msg_,
+                                        this->contact_pub_);
+    return;
+  }
+
+  // the previous message may still be in the publisher queue, fill a
+  // pooled one and hand it over without copying
+  MessagePool<gazebo_msgs::ContactsState>::MessagePtr contact_state_msg =
+    this->contact_state_pool_.acquire(
+      contacts.contact_size() * sizeof(gazebo_msgs::ContactState));
+
   /// \TODO: need a time for each Contact in i-loop, they may differ
-  this->contact_state_msg_.header.frame_id = this->frame_name_;
-  this->contact_state_msg_.header.stamp = ros::Time(contacts.time().sec(),
+  contact_state_msg->header.frame_id = this->frame_name_;
+  contact_state_msg->header.stamp = ros::Time(contacts.time().sec(),
                                contacts.time().nsec());
 
 /*
@@ -187,150 +242,277 @@ void GazeboRosBumper::OnContact()
 */
   // get reference frame (body(link)) pose and subtract from it to get
   // relative force, torque, position and normal vectors
-  ignition::math::Pose3d pose, frame_pose;
-  ignition::math::Quaterniond rot, frame_rot;
-  ignition::math::Vector3d pos, frame_pos;
+  ignition::math::Pose3d frame_pose;
   /*
   if (myFrame)
   {
     frame_pose = myFrame->WorldPose();  //-this->myBody->GetCoMPose();
-    frame_pos = frame_pose.Pos();
-    frame_rot = frame_pose.Rot();
   }
   else
   */
   {
     // no specific frames specified, use identity pose, keeping
     // relative frame at inertial origin
-    frame_pos = ignition::math::Vector3d(0, 0, 0);
-    frame_rot = ignition::math::Quaterniond(1, 0, 0, 0);  // gazebo u,x,y,z == identity
-    frame_pose = ignition::math::Pose3d(frame_pos, frame_rot);
+    frame_pose = ignition::math::Pose3d(ignition::math::Vector3d(0, 0, 0),
+      ignition::math::Quaterniond(1, 0, 0, 0));  // gazebo u,x,y,z == identity
   }
 
+  if (this->output_mode_ == AGGREGATED)
+    AggregateContactsState(contacts, frame_pose, *contact_state_msg);
+  else
+    FillContactsState(contacts, frame_pose, *contact_state_msg);
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_END();
+  IGN_PROFILE_BEGIN("publish");
+#endif
+  this->contact_pub_queue_->push(contact_state_msg, this->contact_pub_);
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_END();
+#endif
+}
 
+////////////////////////////////////////////////////////////////////////////////
+// Convert contacts to a ContactsState message
+void GazeboRosBumper::FillContactsState(const msgs::Contacts &_contacts,
+    const ignition::math::Pose3d &_frame_pose,
+    gazebo_msgs::ContactsState &_msg)
+{
+  // set contact states size, resizing instead of clearing keeps the
+  // arrays of a reused message allocated
+  const int contactsPacketSize = _contacts.contact_size();
+  _msg.states.resize(contactsPacketSize);
 
-  // set contact states size
-  this->contact_state_msg_.states.clear();
+  std::ostringstream stream;
 
   // GetContacts returns all contacts on the collision body
-  unsigned int contactsPacketSize = contacts.contact_size();
-  for (unsigned int i = 0; i < contactsPacketSize; ++i)
+  for (int i = 0; i < contactsPacketSize; ++i)
   {
-
     // For each collision contact
-    // Create a ContactState
-    gazebo_msgs::ContactState state;
-    /// \TODO:
-    gazebo::msgs::Contact contact = contacts.contact(i);
-
-    state.collision1_name = contact.collision1();
-    state.collision2_name = contact.collision2();
-    std::ostringstream stream;
+    // Fill a ContactState
+    const msgs::Contact &contact = _contacts.contact(i);
+    gazebo_msgs::ContactState &state = _msg.states[i];
+    FillContactState(contact, _frame_pose, state);
+
+    stream.str("");
     stream << "Debug:  i:(" << i << "/" << contactsPacketSize
       << ")     my geom:" << state.collision1_name
       << "   other geom:" << state.collision2_name
       << "         time:" << ros::Time(contact.time().sec(), contact.time().nsec())
       << std::endl;
     state.info = stream.str();
+  }
+}
 
-    state.wrenches.clear();
-    state.contact_positions.clear();
-    state.contact_normals.clear();
-    state.depths.clear();
-
-    // sum up all wrenches for each DOF
-    geometry_msgs::Wrench total_wrench;
-    total_wrench.force.x = 0;
-    total_wrench.force.y = 0;
-    total_wrench.force.z = 0;
-    total_wrench.torque.x = 0;
-    total_wrench.torque.y = 0;
-    total_wrench.torque.z = 0;
-
-    unsigned int contactGroupSize = contact.position_size();
-    for (unsigned int j = 0; j < contactGroupSize; ++j)
-    {
-      // loop through individual contacts between collision1 and collision2
-      // gzerr << j << "  Position:"
-      //       << contact.position(j).x() << " "
-      //       << contact.position(j).y() << " "
-      //       << contact.position(j).z() << "\n";
-      // gzerr << "   Normal:"
-      //       << contact.normal(j).x() << " "
-      //       << contact.normal(j).y() << " "
-      //       << contact.normal(j).z() << "\n";
-      // gzerr << "   Depth:" << contact.depth(j) << "\n";
-
-      // Get force, torque and rotate into user specified frame.
-      // frame_rot is identity if world is used (default for now)
-      ignition::math::Vector3d force = frame_rot.RotateVectorReverse(ignition::math::Vector3d(
-                              contact.wrench(j).body_1_wrench().force().x(),
-                            contact.wrench(j).body_1_wrench().force().y(),
-                            contact.wrench(j).body_1_wrench().force().z()));
-      ignition::math::Vector3d torque = frame_rot.RotateVectorReverse(ignition::math::Vector3d(
-                            contact.wrench(j).body_1_wrench().torque().x(),
-                            contact.wrench(j).body_1_wrench().torque().y(),
-                            contact.wrench(j).body_1_wrench().torque().z()));
-
-      // set wrenches
-      geometry_msgs::Wrench wrench;
-      wrench.force.x  = force.X();
-      wrench.force.y  = force.Y();
-      wrench.force.z  = force.Z();
-      wrench.torque.x = torque.X();
-      wrench.torque.y = torque.Y();
-      wrench.torque.z = torque.Z();
-      state.wrenches.push_back(wrench);
-
-      total_wrench.force.x  += wrench.force.x;
-      total_wrench.force.y  += wrench.force.y;
-      total_wrench.force.z  += wrench.force.z;
-      total_wrench.torque.x += wrench.torque.x;
-      total_wrench.torque.y += wrench.torque.y;
-      total_wrench.torque.z += wrench.torque.z;
-
-      // transform contact positions into relative frame
-      // set contact positions
-      ignition::math::Vector3d position = frame_rot.RotateVectorReverse(
-          ignition::math::Vector3d(contact.position(j).x(),
-                                   contact.position(j).y(),
-                                   contact.position(j).z()) - frame_pos);
-      geometry_msgs::Vector3 contact_position;
-      contact_position.x = position.X();
-      contact_position.y = position.Y();
-      contact_position.z = position.Z();
-      state.contact_positions.push_back(contact_position);
-
-      // rotate normal into user specified frame.
-      // frame_rot is identity if world is used.
-      ignition::math::Vector3d normal = frame_rot.RotateVectorReverse(
-          ignition::math::Vector3d(contact.normal(j).x(),
-                                   contact.normal(j).y(),
-                                   contact.normal(j).z()));
-      // set contact normals
-      geometry_msgs::Vector3 contact_normal;
-      contact_normal.x = normal.X();
-      contact_normal.y = normal.Y();
-      contact_normal.z = normal.Z();
-      state.contact_normals.push_back(contact_normal);
-
-      // set contact depth, interpenetration
-      state.depths.push_back(contact.depth(j));
-    }
+////////////////////////////////////////////////////////////////////////////////
+// Convert the contact points of one collision pair
+void GazeboRosBumper::FillContactState(const msgs::Contact &_contact,
+    const ignition::math::Pose3d &_frame_pose,
+    gazebo_msgs::ContactState &_state, bool _swapped)
+{
+  const ignition::math::Vector3d &frame_pos = _frame_pose.Pos();
+  const ignition::math::Quaterniond &frame_rot = _frame_pose.Rot();
+
+  // reported from collision2 when swapped, with the normal reversed
+  _state.collision1_name =
+    _swapped ? _contact.collision2() : _contact.collision1();
+  _state.collision2_name =
+    _swapped ? _contact.collision1() : _contact.collision2();
+  const double normal_sign = _swapped ? -1.0 : 1.0;
+
+  const int contactGroupSize = _contact.position_size();
+  _state.wrenches.resize(contactGroupSize);
+  _state.contact_positions.resize(contactGroupSize);
+  _state.contact_normals.resize(contactGroupSize);
+  _state.depths.resize(contactGroupSize);
+
+  // sum up all wrenches for each DOF
+  geometry_msgs::Wrench total_wrench;
+
+  for (int j = 0; j < contactGroupSize; ++j)
+  {
+    // loop through individual contacts between collision1 and collision2
+
+    // Get force, torque and rotate into user specified frame.
+    // frame_rot is identity if world is used (default for now)
+    const msgs::Wrench &body_wrench = _swapped ?
+      _contact.wrench(j).body_2_wrench() : _contact.wrench(j).body_1_wrench();
+    ignition::math::Vector3d force = frame_rot.RotateVectorReverse(
+        ignition::math::Vector3d(body_wrench.force().x(),
+                                 body_wrench.force().y(),
+                                 body_wrench.force().z()));
+    ignition::math::Vector3d torque = frame_rot.RotateVectorReverse(
+        ignition::math::Vector3d(body_wrench.torque().x(),
+                                 body_wrench.torque().y(),
+                                 body_wrench.torque().z()));
+
+    // set wrenches
+    geometry_msgs::Wrench &wrench = _state.wrenches[j];
+    wrench.force.x  = force.X();
+    wrench.force.y  = force.Y();
+    wrench.force.z  = force.Z();
+    wrench.torque.x = torque.X();
+    wrench.torque.y = torque.Y();
+    wrench.torque.z = torque.Z();
+
+    total_wrench.force.x  += wrench.force.x;
+    total_wrench.force.y  += wrench.force.y;
+    total_wrench.force.z  += wrench.force.z;
+    total_wrench.torque.x += wrench.torque.x;
+    total_wrench.torque.y += wrench.torque.y;
+    total_wrench.torque.z += wrench.torque.z;
+
+    // transform contact positions into relative frame
+    // set contact positions
+    ignition::math::Vector3d position = frame_rot.RotateVectorReverse(
+        ignition::math::Vector3d(_contact.position(j).x(),
+                                 _contact.position(j).y(),
+                                 _contact.position(j).z()) - frame_pos);
+    geometry_msgs::Vector3 &contact_position = _state.contact_positions[j];
+    contact_position.x = position.X();
+    contact_position.y = position.Y();
+    contact_position.z = position.Z();
+
+    // rotate normal into user specified frame.
+    // frame_rot is identity if world is used.
+    ignition::math::Vector3d normal = frame_rot.RotateVectorReverse(
+        ignition::math::Vector3d(_contact.normal(j).x(),
+                                 _contact.normal(j).y(),
+                                 _contact.normal(j).z()) * normal_sign);
+    // set contact normals
+    geometry_msgs::Vector3 &contact_normal = _state.contact_normals[j];
+    contact_normal.x = normal.X();
+    contact_normal.y = normal.Y();
+    contact_normal.z = normal.Z();
+
+    // set contact depth, interpenetration
+    _state.depths[j] = _contact.depth(j);
+  }
+
+  _state.total_wrench = total_wrench;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reduce contacts to one reading per collision pair
+void GazeboRosBumper::AggregateContactsState(const msgs::Contacts &_contacts,
+    const ignition::math::Pose3d &_frame_pose,
+    gazebo_msgs::ContactsState &_msg)
+{
+  const int contactsPacketSize = _contacts.contact_size();
+  _msg.states.resize(contactsPacketSize);
 
-    state.total_wrench = total_wrench;
-    this->contact_state_msg_.states.push_back(state);
+  for (int i = 0; i < contactsPacketSize; ++i)
+    AggregateContactState(_contacts.contact(i), _frame_pose, _msg.states[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reduce the contact points of one collision pair
+void GazeboRosBumper::AggregateContactState(const msgs::Contact &_contact,
+    const ignition::math::Pose3d &_frame_pose,
+    gazebo_msgs::ContactState &_state, bool _swapped)
+{
+  const ignition::math::Vector3d &frame_pos = _frame_pose.Pos();
+  const ignition::math::Quaterniond &frame_rot = _frame_pose.Rot();
+
+  // reported from collision2 when swapped, with the normal reversed
+  _state.collision1_name =
+    _swapped ? _contact.collision2() : _contact.collision1();
+  _state.collision2_name =
+    _swapped ? _contact.collision1() : _contact.collision2();
+  const double normal_sign = _swapped ? -1.0 : 1.0;
+  _state.info.clear();
+
+  // one pass over the contact points summing in world frame, the frame
+  // transform is linear and applied once to the sums
+  double force[3] = {0, 0, 0};
+  double torque[3] = {0, 0, 0};
+  double position[3] = {0, 0, 0};
+  double normal[3] = {0, 0, 0};
+  double depth = 0;
+  const int contactGroupSize = _contact.position_size();
+  for (int j = 0; j < contactGroupSize; ++j)
+  {
+    const msgs::Wrench &body_wrench = _swapped ?
+      _contact.wrench(j).body_2_wrench() : _contact.wrench(j).body_1_wrench();
+    force[0] += body_wrench.force().x();
+    force[1] += body_wrench.force().y();
+    force[2] += body_wrench.force().z();
+    torque[0] += body_wrench.torque().x();
+    torque[1] += body_wrench.torque().y();
+    torque[2] += body_wrench.torque().z();
+    position[0] += _contact.position(j).x();
+    position[1] += _contact.position(j).y();
+    position[2] += _contact.position(j).z();
+    normal[0] += _contact.normal(j).x();
+    normal[1] += _contact.normal(j).y();
+    normal[2] += _contact.normal(j).z();
+    depth = std::max(depth, _contact.depth(j));
   }
-#ifdef ENABLE_PROFILER
-  IGN_PROFILE_END();
-  IGN_PROFILE_BEGIN("publish");
-#endif
-  this->contact_pub_.publish(this->contact_state_msg_);
-#ifdef ENABLE_PROFILER
-  IGN_PROFILE_END();
-#endif
+
+  if (contactGroupSize == 0)
+  {
+    _state.wrenches.clear();
+    _state.contact_positions.clear();
+    _state.contact_normals.clear();
+    _state.depths.clear();
+    _state.total_wrench = geometry_msgs::Wrench();
+    return;
+  }
+
+  const ignition::math::Vector3d total_force = frame_rot.RotateVectorReverse(
+      ignition::math::Vector3d(force[0], force[1], force[2]));
+  const ignition::math::Vector3d total_torque = frame_rot.RotateVectorReverse(
+      ignition::math::Vector3d(torque[0], torque[1], torque[2]));
+  const ignition::math::Vector3d centroid = frame_rot.RotateVectorReverse(
+      ignition::math::Vector3d(position[0], position[1], position[2]) /
+      contactGroupSize - frame_pos);
+  // opposite normals of a pair cancel, leaving a zero normal
+  ignition::math::Vector3d mean_normal = frame_rot.RotateVectorReverse(
+      ignition::math::Vector3d(normal[0], normal[1], normal[2]) * normal_sign);
+  if (mean_normal.Length() > 1e-9)
+    mean_normal.Normalize();
+
+  _state.total_wrench.force.x  = total_force.X();
+  _state.total_wrench.force.y  = total_force.Y();
+  _state.total_wrench.force.z  = total_force.Z();
+  _state.total_wrench.torque.x = total_torque.X();
+  _state.total_wrench.torque.y = total_torque.Y();
+  _state.total_wrench.torque.z = total_torque.Z();
+  _state.wrenches.assign(1, _state.total_wrench);
+
+  _state.contact_positions.resize(1);
+  _state.contact_positions[0].x = centroid.X();
+  _state.contact_positions[0].y = centroid.Y();
+  _state.contact_positions[0].z = centroid.Z();
+
+  _state.contact_normals.resize(1);
+  _state.contact_normals[0].x = mean_normal.X();
+  _state.contact_normals[0].y = mean_normal.Y();
+  _state.contact_normals[0].z = mean_normal.Z();
+
+  _state.depths.assign(1, depth);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Flag the collisions of the sensor that touch anything
+void GazeboRosBumper::FillContactMask(const msgs::Contacts &_contacts,
+    gazebo_msgs::ContactMask &_msg)
+{
+  // a contact sensor has a handful of collisions, a linear search is fine
+  const size_t collisionCount = _msg.collision_names.size();
+  _msg.in_contact.assign(collisionCount, false);
+  for (int i = 0; i < _contacts.contact_size(); ++i)
+  {
+    const msgs::Contact &contact = _contacts.contact(i);
+    if (contact.position_size() == 0)
+      continue;
+    for (size_t k = 0; k < collisionCount; ++k)
+    {
+      if (contact.collision1() == _msg.collision_names[k] ||
+          contact.collision2() == _msg.collision_names[k])
+        _msg.in_contact[k] = true;
+    }
+  }
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 // Put laser data to the interface
@@ -0,0 +1,201 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <cmath>
+#include <cstring>
+
+#include <gazebo_plugins/gazebo_ros_camera_remap.h>
+
+namespace gazebo
+{
+// fractional bits of the bilinear weights, four weights of at most
+// 1 << 14 fit uint16_t and a weighted sum of 16 bit pixels fits uint32_t
+static const unsigned int weight_bits = 14;
+static const uint32_t weight_one = 1u << weight_bits;
+
+// number of fixed point iterations used to invert the distortion model
+static const unsigned int undistort_iterations = 20;
+
+////////////////////////////////////////////////////////////////////////////////
+// Apply the plumb_bob model to normalized image coordinates
+static void Distort(const double _d[5], double _x, double _y,
+                    double &_xd, double &_yd)
+{
+  double r2 = _x*_x + _y*_y;
+  double radial = 1.0 + r2*(_d[0] + r2*(_d[1] + r2*_d[4]));
+  _xd = _x*radial + 2.0*_d[2]*_x*_y + _d[3]*(r2 + 2.0*_x*_x);
+  _yd = _y*radial + _d[2]*(r2 + 2.0*_y*_y) + 2.0*_d[3]*_x*_y;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Invert the plumb_bob model iteratively, as done by cv::undistortPoints
+static void Undistort(const double _d[5], double _xd, double _yd,
+                      double &_x, double &_y)
+{
+  _x = _xd;
+  _y = _yd;
+  for (unsigned int i = 0; i < undistort_iterations; ++i)
+  {
+    double r2 = _x*_x + _y*_y;
+    double radial = 1.0 + r2*(_d[0] + r2*(_d[1] + r2*_d[4]));
+    double dx = 2.0*_d[2]*_x*_y + _d[3]*(r2 + 2.0*_x*_x);
+    double dy = _d[2]*(r2 + 2.0*_y*_y) + 2.0*_d[3]*_x*_y;
+    _x = (_xd - dx) / radial;
+    _y = (_yd - dy) / radial;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+GazeboRosCameraRemap::GazeboRosCameraRemap()
+  : width_(0), height_(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build the remap table
+void GazeboRosCameraRemap::Build(unsigned int _width, unsigned int _height,
+  double _focal_length, double _cx, double _cy, const double _d[5],
+  Direction _direction)
+{
+  this->width_ = _width;
+  this->height_ = _height;
+
+  const size_t size = static_cast<size_t>(_width) * _height;
+  this->offsets_.assign(size, -1);
+  this->w00_.assign(size, 0);
+  this->w01_.assign(size, 0);
+  this->w10_.assign(size, 0);
+  this->w11_.assign(size, 0);
+
+  // bilinear interpolation needs two pixels in each direction
+  if (_width < 2 || _height < 2 || _focal_length <= 0)
+    return;
+
+  for (unsigned int v = 0; v < _height; ++v)
+  {
+    for (unsigned int u = 0; u < _width; ++u)
+    {
+      // normalized coordinates of the destination pixel
+      double x = (u - _cx) / _focal_length;
+      double y = (v - _cy) / _focal_length;
+
+      // coordinates of the same ray in the source image
+      double xs, ys;
+      if (_direction == RECTIFY)
+        Distort(_d, x, y, xs, ys);
+      else
+        Undistort(_d, x, y, xs, ys);
+      double sx = xs * _focal_length + _cx;
+      double sy = ys * _focal_length + _cy;
+
+      if (!(sx >= 0.0 && sy >= 0.0 && sx <= _width - 1 && sy <= _height - 1))
+        continue;
+
+      unsigned int x0 = static_cast<unsigned int>(sx);
+      unsigned int y0 = static_cast<unsigned int>(sy);
+      // keep the right and bottom neighbour inside of the image
+      if (x0 == _width - 1)
+        --x0;
+      if (y0 == _height - 1)
+        --y0;
+
+      uint32_t ax = static_cast<uint32_t>((sx - x0) * weight_one + 0.5);
+      uint32_t ay = static_cast<uint32_t>((sy - y0) * weight_one + 0.5);
+      if (ax > weight_one)
+        ax = weight_one;
+      if (ay > weight_one)
+        ay = weight_one;
+
+      // round each product so the four weights still sum up to weight_one
+      uint32_t w11 = (ax * ay + weight_one / 2) >> weight_bits;
+      uint32_t w01 = ax - w11;
+      uint32_t w10 = ay - w11;
+      uint32_t w00 = weight_one - w01 - w10 - w11;
+
+      const size_t i = static_cast<size_t>(v) * _width + u;
+      this->offsets_[i] = static_cast<int32_t>(y0 * _width + x0);
+      this->w00_[i] = static_cast<uint16_t>(w00);
+      this->w01_[i] = static_cast<uint16_t>(w01);
+      this->w10_[i] = static_cast<uint16_t>(w10);
+      this->w11_[i] = static_cast<uint16_t>(w11);
+    }
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// True once a table has been built
+bool GazeboRosCameraRemap::Valid() const
+{
+  return !this->offsets_.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remap an image
+void GazeboRosCameraRemap::Apply(const unsigned char *_src,
+  unsigned char *_dst, unsigned int _channels,
+  unsigned int _bytes_per_channel) const
+{
+  if (_bytes_per_channel == 2)
+  {
+    this->ApplyChannels(reinterpret_cast<const uint16_t*>(_src),
+                        reinterpret_cast<uint16_t*>(_dst), _channels);
+  }
+  else
+  {
+    this->ApplyChannels(_src, _dst, _channels);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Remap kernel, blends the four source neighbours of each pixel with the
+// fixed point weights of the table, pixels that map outside the source
+// image are cleared
+template<typename T>
+void GazeboRosCameraRemap::ApplyChannels(const T *_src, T *_dst,
+  unsigned int _channels) const
+{
+  const size_t size = this->offsets_.size();
+  const size_t row = static_cast<size_t>(this->width_) * _channels;
+  const int32_t *offsets = &this->offsets_[0];
+  const uint16_t *w00 = &this->w00_[0];
+  const uint16_t *w01 = &this->w01_[0];
+  const uint16_t *w10 = &this->w10_[0];
+  const uint16_t *w11 = &this->w11_[0];
+
+  for (size_t i = 0; i < size; ++i)
+  {
+    T *dst = _dst + i * _channels;
+    if (offsets[i] < 0)
+    {
+      memset(dst, 0, _channels * sizeof(T));
+      continue;
+    }
+
+    const T *p00 = _src + static_cast<size_t>(offsets[i]) * _channels;
+    const T *p10 = p00 + row;
+    for (unsigned int c = 0; c < _channels; ++c)
+    {
+      uint32_t sum = w00[i] * static_cast<uint32_t>(p00[c]) +
+                     w01[i] * static_cast<uint32_t>(p00[c + _channels]) +
+                     w10[i] * static_cast<uint32_t>(p10[c]) +
+                     w11[i] * static_cast<uint32_t>(p10[c + _channels]);
+      dst[c] = static_cast<T>((sum + weight_one / 2) >> weight_bits);
+    }
+  }
+}
+}
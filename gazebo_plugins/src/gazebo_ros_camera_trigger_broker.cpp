@@ -0,0 +1,232 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include "gazebo_plugins/gazebo_ros_camera_trigger_broker.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <gazebo_plugins/gazebo_ros_triggered_camera.h>
+
+#ifdef ENABLE_PROFILER
+#include <ignition/common/Profiler.hh>
+#endif
+
+namespace gazebo
+{
+// Register this plugin with the simulator
+GZ_REGISTER_WORLD_PLUGIN(GazeboRosCameraTriggerBroker)
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+GazeboRosCameraTriggerBroker::GazeboRosCameraTriggerBroker()
+  : rosnode_(NULL)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+GazeboRosCameraTriggerBroker::~GazeboRosCameraTriggerBroker()
+{
+  this->pre_render_connection_.reset();
+  this->published_connection_.reset();
+
+  if (this->rosnode_)
+  {
+    this->queue_.clear();
+    this->queue_.disable();
+    this->rosnode_->shutdown();
+    this->callback_queue_thread_.join();
+    delete this->rosnode_;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Load the controller
+void GazeboRosCameraTriggerBroker::Load(physics::WorldPtr _world,
+  sdf::ElementPtr _sdf)
+{
+  // Make sure the ROS node for Gazebo has already been initialized
+  if (!ros::isInitialized())
+  {
+    ROS_FATAL_STREAM_NAMED("camera_trigger_broker", "A ROS node for Gazebo has not been initialized, unable to load plugin. "
+      << "Load the Gazebo system plugin 'libgazebo_ros_api_plugin.so' in the gazebo_ros package)");
+    return;
+  }
+
+  this->world_ = _world;
+
+  std::string robot_namespace;
+  if (_sdf->HasElement("robotNamespace"))
+    robot_namespace = _sdf->Get<std::string>("robotNamespace");
+
+  std::string trigger_topic_name = "trigger_camera_group";
+  if (_sdf->HasElement("triggerTopicName"))
+    trigger_topic_name = _sdf->Get<std::string>("triggerTopicName");
+
+  std::string latency_topic_name = "camera_trigger_latency";
+  if (_sdf->HasElement("latencyTopicName"))
+    latency_topic_name = _sdf->Get<std::string>("latencyTopicName");
+
+  this->rosnode_ = new ros::NodeHandle(robot_namespace);
+
+  ros::SubscribeOptions so =
+    ros::SubscribeOptions::create<std_msgs::String>(
+    trigger_topic_name, 10,
+    boost::bind(&GazeboRosCameraTriggerBroker::OnTrigger, this, _1),
+    ros::VoidPtr(), &this->queue_);
+  this->trigger_sub_ = this->rosnode_->subscribe(so);
+
+  this->latency_pub_ =
+    this->rosnode_->advertise<gazebo_msgs::CameraTriggerLatency>(
+    latency_topic_name, 10);
+
+  this->callback_queue_thread_ = boost::thread(
+    boost::bind(&GazeboRosCameraTriggerBroker::QueueThread, this));
+
+  this->published_connection_ =
+    GazeboRosTriggeredCameraGroups::Instance().ConnectPublished(
+    std::bind(&GazeboRosCameraTriggerBroker::OnPublished, this,
+    std::placeholders::_1, std::placeholders::_2));
+
+  this->pre_render_connection_ = event::Events::ConnectPreRender(
+    std::bind(&GazeboRosCameraTriggerBroker::PreRender, this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Queue a group trigger
+void GazeboRosCameraTriggerBroker::OnTrigger(
+  const std_msgs::String::ConstPtr &_msg)
+{
+  TriggerRequest request;
+  request.group = _msg->data;
+#if GAZEBO_MAJOR_VERSION >= 8
+  request.sim_time = this->world_->SimTime();
+#else
+  request.sim_time = this->world_->GetSimTime();
+#endif
+  request.wall_time = common::Time::GetWallTime();
+
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  this->pending_.push_back(request);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Trigger all queued groups before the render pass
+void GazeboRosCameraTriggerBroker::PreRender()
+{
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE("GazeboRosCameraTriggerBroker::PreRender");
+#endif
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  if (this->pending_.empty())
+    return;
+
+  for (const TriggerRequest &request : this->pending_)
+  {
+    // a group triggered again before all of its cameras published reports
+    // the cameras that did not publish with a latency of -1
+    auto previous = this->triggered_.find(request.group);
+    if (previous != this->triggered_.end())
+    {
+      this->PublishLatency(previous->second.msg);
+      this->triggered_.erase(previous);
+    }
+
+    // all cameras of the group are enabled together here, so they render in
+    // the same pass regardless of the order of their own PreRender callbacks
+    std::vector<std::string> names =
+      GazeboRosTriggeredCameraGroups::Instance().Trigger(request.group);
+    if (names.empty())
+    {
+      ROS_WARN_NAMED("camera_trigger_broker",
+        "No triggered cameras in group [%s]", request.group.c_str());
+      continue;
+    }
+
+    TriggeredGroup &group = this->triggered_[request.group];
+    group.sim_time = request.sim_time;
+    group.wall_time = request.wall_time;
+    group.remaining = names.size();
+    group.msg.header.stamp.sec = request.sim_time.sec;
+    group.msg.header.stamp.nsec = request.sim_time.nsec;
+    group.msg.group = request.group;
+    group.msg.camera_names = names;
+    group.msg.sim_latency.assign(names.size(), -1.0);
+    group.msg.real_latency.assign(names.size(), -1.0);
+  }
+  this->pending_.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Record the latency of a published frame
+void GazeboRosCameraTriggerBroker::OnPublished(const std::string &_group,
+  const std::string &_camera)
+{
+  std::lock_guard<std::mutex> lock(this->mutex_);
+  auto triggered = this->triggered_.find(_group);
+  if (triggered == this->triggered_.end())
+    return;
+
+  TriggeredGroup &group = triggered->second;
+  auto name = std::find(group.msg.camera_names.begin(),
+    group.msg.camera_names.end(), _camera);
+  if (name == group.msg.camera_names.end())
+    return;
+
+  size_t index = name - group.msg.camera_names.begin();
+  if (group.msg.real_latency[index] >= 0.0)
+    return;
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  common::Time sim_time = this->world_->SimTime();
+#else
+  common::Time sim_time = this->world_->GetSimTime();
+#endif
+  group.msg.sim_latency[index] = (sim_time - group.sim_time).Double();
+  group.msg.real_latency[index] =
+    (common::Time::GetWallTime() - group.wall_time).Double();
+
+  if (--group.remaining == 0)
+  {
+    this->PublishLatency(group.msg);
+    this->triggered_.erase(triggered);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Publish the latencies of a group trigger
+void GazeboRosCameraTriggerBroker::PublishLatency(
+  gazebo_msgs::CameraTriggerLatency &_msg)
+{
+  if (this->latency_pub_.getNumSubscribers() > 0)
+    this->latency_pub_.publish(_msg);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Custom callback queue thread
+void GazeboRosCameraTriggerBroker::QueueThread()
+{
+  static const double timeout = 0.01;
+
+  while (this->rosnode_->ok())
+  {
+    this->queue_.callAvailable(ros::WallDuration(timeout));
+  }
+}
+}
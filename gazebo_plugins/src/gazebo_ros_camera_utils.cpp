@@ -17,6 +17,7 @@
 
 #include <string>
 #include <algorithm>
+#include <cstring>
 #include <assert.h>
 #include <boost/thread/thread.hpp>
 #include <boost/bind.hpp>
@@ -25,6 +26,7 @@
 #include <tf/transform_listener.h>
 #include <sensor_msgs/Image.h>
 #include <sensor_msgs/fill_image.h>
+#include <sensor_msgs/image_encodings.h>
 #include <image_transport/image_transport.h>
 #include <geometry_msgs/Point32.h>
 #include <sensor_msgs/ChannelFloat32.h>
@@ -55,6 +57,7 @@ GazeboRosCameraUtils::GazeboRosCameraUtils()
   this->width_ = 0;
   this->skip_ = 0;
   this->format_ = "";
+  this->distort_image_ = false;
   this->initialized_ = false;
 }
 
@@ -253,6 +256,18 @@ void GazeboRosCameraUtils::Load(sensors::SensorPtr _parent,
   else
     this->border_crop_ = this->sdf->Get<bool>("borderCrop");
 
+  // publish a rectified copy of every image alongside the raw image
+  if (this->sdf->HasElement("rectifiedImageTopicName"))
+    this->rect_image_topic_name_ =
+      this->sdf->Get<std::string>("rectifiedImageTopicName");
+
+  // distort the rendered image in the plugin with the distortion
+  // coefficients above, for sensors without gazebo lens distortion
+  if (!this->sdf->HasElement("distortImage"))
+    this->distort_image_ = false;
+  else
+    this->distort_image_ = this->sdf->Get<bool>("distortImage");
+
   // initialize shared_ptr members
   if (!this->image_connect_count_) this->image_connect_count_ = boost::shared_ptr<int>(new int(0));
   if (!this->image_connect_count_lock_) this->image_connect_count_lock_ = boost::shared_ptr<boost::mutex>(new boost::mutex);
@@ -324,6 +339,15 @@ void GazeboRosCameraUtils::LoadThread()
     boost::bind(&GazeboRosCameraUtils::ImageDisconnect, this),
     ros::VoidPtr(), true);
 
+  if (!this->rect_image_topic_name_.empty())
+  {
+    this->rect_pub_ = this->itnode_->advertise(
+      this->rect_image_topic_name_, 2,
+      boost::bind(&GazeboRosCameraUtils::ImageConnect, this),
+      boost::bind(&GazeboRosCameraUtils::ImageDisconnect, this),
+      ros::VoidPtr(), true);
+  }
+
   // camera info publish rate will be synchronized to image sensor
   // publish rates.
   // If someone connects to camera_info, sensor will be activated
@@ -619,6 +643,8 @@ void GazeboRosCameraUtils::Init()
 
   this->camera_info_manager_->setCameraInfo(camera_info_msg);
 
+  this->InitRemap();
+
   // start custom queue for camera_
   this->callback_queue_thread_ = boost::thread(
     boost::bind(&GazeboRosCameraUtils::CameraQueueThread, this));
@@ -646,20 +672,86 @@ void GazeboRosCameraUtils::PutCameraData(const unsigned char *_src)
   {
     boost::mutex::scoped_lock lock(this->lock_);
 
-    // copy data into image
-    this->image_msg_.header.frame_id = this->frame_name_;
-    this->image_msg_.header.stamp.sec = this->sensor_update_time_.sec;
-    this->image_msg_.header.stamp.nsec = this->sensor_update_time_.nsec;
+    const bool remap = this->remap_.Valid();
+    const int bytes = sensor_msgs::image_encodings::bitDepth(this->type_) / 8;
+    const int channels = sensor_msgs::image_encodings::numChannels(this->type_);
 
-    // copy from src to image_msg_
-    fillImage(this->image_msg_, this->type_, this->height_, this->width_,
-        this->skip_*this->width_, reinterpret_cast<const void*>(_src));
+    // fill a pooled image, it is reused once all subscribers released it
+    sensor_msgs::ImagePtr image = this->AcquireImage(this->image_pool_);
+    if (remap && this->distort_image_)
+      this->remap_.Apply(_src, &image->data[0], channels, bytes);
+    else
+      memcpy(&image->data[0], _src, image->data.size());
 
     // publish to ros
-    this->image_pub_.publish(this->image_msg_);
+    this->image_pub_.publish(image);
+    this->last_image_ = image;
+
+    // the rectified image of the pair comes from the same rendered frame
+    if (remap && this->rect_pub_.getNumSubscribers() > 0)
+    {
+      sensor_msgs::ImagePtr rect = this->AcquireImage(this->remap_pool_);
+      if (this->distort_image_)
+        memcpy(&rect->data[0], _src, rect->data.size());
+      else
+        this->remap_.Apply(_src, &rect->data[0], channels, bytes);
+      this->rect_pub_.publish(rect);
+    }
   }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Get a pooled image with header and layout of the camera image
+sensor_msgs::ImagePtr GazeboRosCameraUtils::AcquireImage(
+  MessagePool<sensor_msgs::Image> &_pool)
+{
+  sensor_msgs::ImagePtr image =
+    _pool.acquire(this->skip_*this->width_*this->height_);
+
+  image->header.frame_id = this->frame_name_;
+  image->header.stamp.sec = this->sensor_update_time_.sec;
+  image->header.stamp.nsec = this->sensor_update_time_.nsec;
+  image->encoding = this->type_;
+  image->height = this->height_;
+  image->width = this->width_;
+  image->step = this->skip_*this->width_;
+  image->is_bigendian = 0;
+  image->data.resize(image->step * image->height);
+
+  return image;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Build the remap table from the distortion coefficients
+void GazeboRosCameraUtils::InitRemap()
+{
+  if (this->rect_image_topic_name_.empty() && !this->distort_image_)
+    return;
+
+  if (sensor_msgs::image_encodings::isBayer(this->type_))
+  {
+    ROS_WARN_NAMED("camera_utils", "Camera [%s] can not rectify or distort"
+      " bayer images, ignoring <rectifiedImageTopicName> and <distortImage>.",
+      this->camera_name_.c_str());
+    this->distort_image_ = false;
+    return;
+  }
+
+  if (this->distort_image_ && this->camera_->LensDistortion())
+  {
+    ROS_WARN_NAMED("camera_utils", "Camera [%s] already applies lens"
+      " distortion, ignoring <distortImage>.", this->camera_name_.c_str());
+    this->distort_image_ = false;
+  }
+
+  // D = {k1, k2, t1, t2, k3} as in CameraInfo
+  const double d[5] = {this->distortion_k1_, this->distortion_k2_,
+    this->distortion_t1_, this->distortion_t2_, this->distortion_k3_};
+  this->remap_.Build(this->width_, this->height_, this->focal_length_,
+    this->cx_, this->cy_, d, this->distort_image_ ?
+    GazeboRosCameraRemap::DISTORT : GazeboRosCameraRemap::RECTIFY);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Put camera_ data to the interface
 void GazeboRosCameraUtils::PublishCameraInfo(common::Time &last_update_time)
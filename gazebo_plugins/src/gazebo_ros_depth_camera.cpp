@@ -21,6 +21,7 @@
  */
 
 #include <algorithm>
+#include <functional>
 #include <assert.h>
 #include <boost/thread/thread.hpp>
 #include <boost/bind.hpp>
@@ -37,7 +38,6 @@
 
 #include <sensor_msgs/point_cloud2_iterator.h>
 
-#include <tf/tf.h>
 
 namespace gazebo
 {
@@ -53,6 +53,7 @@ GazeboRosDepthCamera::GazeboRosDepthCamera()
   this->depth_image_connect_count_ = 0;
   this->depth_info_connect_count_ = 0;
   this->reflectance_connect_count_ = 0;
+  this->disparity_connect_count_ = 0;
   this->last_depth_image_camera_info_update_time_ = common::Time(0);
 }
 
@@ -72,6 +73,12 @@ void GazeboRosDepthCamera::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf
 {
   DepthCameraPlugin::Load(_parent, _sdf);
 
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+  // reflectance and normals are only requested once they have subscribers
+  this->newReflectanceFrameConnection.reset();
+  this->newNormalsFrameConnection.reset();
+#endif
+
   // Make sure the ROS node for Gazebo has already been initialized
   if (!ros::isInitialized())
   {
@@ -118,6 +125,18 @@ void GazeboRosDepthCamera::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf
   else
     this->depth_image_topic_name_ = _sdf->GetElement("depthImageTopicName")->Get<std::string>();
 
+  // disparity image stuff
+  if (!_sdf->HasElement("disparityTopicName"))
+    this->disparity_topic_name_ = "depth/disparity";
+  else
+    this->disparity_topic_name_ = _sdf->GetElement("disparityTopicName")->Get<std::string>();
+
+  // default to the baseline between Kinect IR projector and camera
+  if (!_sdf->HasElement("disparityBaseline"))
+    this->disparity_baseline_ = 0.075;
+  else
+    this->disparity_baseline_ = _sdf->GetElement("disparityBaseline")->Get<double>();
+
   if (!_sdf->HasElement("depthImageCameraInfoTopicName"))
     this->depth_image_camera_info_topic_name_ = "depth/camera_info";
   else
@@ -169,6 +188,14 @@ void GazeboRosDepthCamera::Advertise()
         ros::VoidPtr(), &this->camera_queue_);
   this->depth_image_camera_info_pub_ = this->rosnode_->advertise(depth_image_camera_info_ao);
 
+  ros::AdvertiseOptions disparity_ao =
+    ros::AdvertiseOptions::create<stereo_msgs::DisparityImage>(
+      this->disparity_topic_name_,1,
+      boost::bind( &GazeboRosDepthCamera::DisparityConnect,this),
+      boost::bind( &GazeboRosDepthCamera::DisparityDisconnect,this),
+      ros::VoidPtr(), &this->camera_queue_);
+  this->disparity_pub_ = this->rosnode_->advertise(disparity_ao);
+
 #if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
   ros::AdvertiseOptions reflectance_ao =
     ros::AdvertiseOptions::create<sensor_msgs::Image>(
@@ -179,7 +206,7 @@ void GazeboRosDepthCamera::Advertise()
   this->reflectance_pub_ = this->rosnode_->advertise(reflectance_ao);
 
   ros::AdvertiseOptions normals_ao =
-    ros::AdvertiseOptions::create<visualization_msgs::MarkerArray >(
+    ros::AdvertiseOptions::create<sensor_msgs::PointCloud2 >(
       normals_topic_name_, 1,
       boost::bind( &GazeboRosDepthCamera::NormalsConnect,this),
       boost::bind( &GazeboRosDepthCamera::NormalsDisconnect,this),
@@ -213,6 +240,9 @@ void GazeboRosDepthCamera::ReflectanceConnect()
 {
   this->reflectance_connect_count_++;
   (*this->image_connect_count_)++;
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+  this->UpdateAuxiliaryConnections();
+#endif
   this->parentSensor->SetActive(true);
 }
 
@@ -222,6 +252,9 @@ void GazeboRosDepthCamera::NormalsConnect()
 {
   this->normals_connect_count_++;
   (*this->image_connect_count_)++;
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+  this->UpdateAuxiliaryConnections();
+#endif
   this->parentSensor->SetActive(true);
 }
 
@@ -231,6 +264,9 @@ void GazeboRosDepthCamera::ReflectanceDisconnect()
 {
   this->reflectance_connect_count_--;
   (*this->image_connect_count_)--;
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+  this->UpdateAuxiliaryConnections();
+#endif
   if (this->reflectance_connect_count_ <= 0)
     this->parentSensor->SetActive(false);
 }
@@ -241,7 +277,10 @@ void GazeboRosDepthCamera::NormalsDisconnect()
 {
   this->normals_connect_count_--;
   (*this->image_connect_count_)--;
-  if (this->reflectance_connect_count_ <= 0)
+#if GAZEBO_MAJOR_VERSION == 9 && GAZEBO_MINOR_VERSION > 12
+  this->UpdateAuxiliaryConnections();
+#endif
+  if (this->normals_connect_count_ <= 0)
     this->parentSensor->SetActive(false);
 }
 
@@ -260,6 +299,21 @@ void GazeboRosDepthCamera::DepthImageDisconnect()
   this->depth_image_connect_count_--;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Increment count
+void GazeboRosDepthCamera::DisparityConnect()
+{
+  this->disparity_connect_count_++;
+  this->parentSensor->SetActive(true);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Decrement count
+void GazeboRosDepthCamera::DisparityDisconnect()
+{
+  this->disparity_connect_count_--;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 // Increment count
 void GazeboRosDepthCamera::DepthInfoConnect()
@@ -297,6 +351,7 @@ void GazeboRosDepthCamera::OnNewDepthFrame(const float *_image,
   {
     if (this->point_cloud_connect_count_ <= 0 &&
         this->depth_image_connect_count_ <= 0 &&
+        this->disparity_connect_count_ <= 0 &&
         (*this->image_connect_count_) <= 0 &&
         this->normals_connect_count_ <= 0)
     {
@@ -312,6 +367,9 @@ void GazeboRosDepthCamera::OnNewDepthFrame(const float *_image,
 
       if (this->depth_image_connect_count_ > 0)
         this->FillDepthImage(_image);
+
+      if (this->disparity_connect_count_ > 0)
+        this->FillDisparityImage(_image);
     }
   }
   else
@@ -363,23 +421,26 @@ void GazeboRosDepthCamera::OnNewRGBPointCloud(const float *_pcd,
 
       memcpy(pcd_, _pcd, sizeof(float)* _width * _height * 4);
 
-      this->point_cloud_msg_.header.frame_id = this->frame_name_;
-      this->point_cloud_msg_.header.stamp.sec = this->depth_sensor_update_time_.sec;
-      this->point_cloud_msg_.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
-      this->point_cloud_msg_.width = this->width;
-      this->point_cloud_msg_.height = this->height;
-      this->point_cloud_msg_.row_step = this->point_cloud_msg_.point_step * this->width;
+      sensor_msgs::PointCloud2Ptr point_cloud_msg =
+        this->point_cloud_pool_.acquire(_width * _height * 32);
+
+      point_cloud_msg->header.frame_id = this->frame_name_;
+      point_cloud_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+      point_cloud_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+      point_cloud_msg->width = this->width;
+      point_cloud_msg->height = this->height;
+      point_cloud_msg->row_step = point_cloud_msg->point_step * this->width;
 
-      sensor_msgs::PointCloud2Modifier pcd_modifier(point_cloud_msg_);
+      sensor_msgs::PointCloud2Modifier pcd_modifier(*point_cloud_msg);
       pcd_modifier.setPointCloud2FieldsByString(2, "xyz", "rgb");
       pcd_modifier.resize(_width*_height);
 
-      point_cloud_msg_.is_dense = true;
+      point_cloud_msg->is_dense = true;
 
-      sensor_msgs::PointCloud2Iterator<float> iter_x(point_cloud_msg_, "x");
-      sensor_msgs::PointCloud2Iterator<float> iter_y(point_cloud_msg_, "y");
-      sensor_msgs::PointCloud2Iterator<float> iter_z(point_cloud_msg_, "z");
-      sensor_msgs::PointCloud2Iterator<float> iter_rgb(point_cloud_msg_, "rgb");
+      sensor_msgs::PointCloud2Iterator<float> iter_x(*point_cloud_msg, "x");
+      sensor_msgs::PointCloud2Iterator<float> iter_y(*point_cloud_msg, "y");
+      sensor_msgs::PointCloud2Iterator<float> iter_z(*point_cloud_msg, "z");
+      sensor_msgs::PointCloud2Iterator<float> iter_rgb(*point_cloud_msg, "rgb");
 
       for (unsigned int i = 0; i < _width; i++)
       {
@@ -393,7 +454,7 @@ void GazeboRosDepthCamera::OnNewRGBPointCloud(const float *_pcd,
         }
       }
 
-      this->point_cloud_pub_.publish(this->point_cloud_msg_);
+      this->point_cloud_pub_.publish(point_cloud_msg);
       this->lock_.unlock();
     }
   }
@@ -423,17 +484,20 @@ void GazeboRosDepthCamera::OnNewReflectanceFrame(const float *_image,
   {
     boost::mutex::scoped_lock lock(this->lock_);
 
+    sensor_msgs::ImagePtr reflectance_msg =
+      this->reflectance_pool_.acquire(4 * _width * _height);
+
     // copy data into image
-    this->reflectance_msg_.header.frame_id = this->frame_name_;
-    this->reflectance_msg_.header.stamp.sec = this->sensor_update_time_.sec;
-    this->reflectance_msg_.header.stamp.nsec = this->sensor_update_time_.nsec;
+    reflectance_msg->header.frame_id = this->frame_name_;
+    reflectance_msg->header.stamp.sec = this->sensor_update_time_.sec;
+    reflectance_msg->header.stamp.nsec = this->sensor_update_time_.nsec;
 
-    // copy from src to image_msg_
-    fillImage(this->reflectance_msg_, sensor_msgs::image_encodings::TYPE_32FC1, _height, _width,
+    // copy from src to reflectance image
+    fillImage(*reflectance_msg, sensor_msgs::image_encodings::TYPE_32FC1, _height, _width,
         4*_width, reinterpret_cast<const void*>(_image));
 
     // publish to ros
-    this->reflectance_pub_.publish(this->reflectance_msg_);
+    this->reflectance_pub_.publish(reflectance_msg);
   }
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
@@ -495,8 +559,6 @@ void GazeboRosDepthCamera::OnNewNormalsFrame(const float * _normals,
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_BEGIN("fill ROS message");
 #endif
-  visualization_msgs::MarkerArray m_array;
-
   if (!this->parentSensor->IsActive())
   {
     if (this->normals_connect_count_ > 0)
@@ -509,70 +571,95 @@ void GazeboRosDepthCamera::OnNewNormalsFrame(const float * _normals,
     {
       boost::mutex::scoped_lock lock(this->lock_);
       if (pcd_ != nullptr)
-      {
-        for (unsigned int i = 0; i < _width; i++)
-        {
-          for (unsigned int j = 0; j < _height; j++)
-          {
-            // plotting some of the normals, otherwise rviz will block it
-            unsigned int index = (j * _width) + i;
-            if (index % this->reduce_normals_ == 0)
-            {
-              visualization_msgs::Marker m;
-              m.type = visualization_msgs::Marker::ARROW;
-              m.header.frame_id = this->frame_name_;
-              m.header.stamp.sec = this->depth_sensor_update_time_.sec;
-              m.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
-              m.action = visualization_msgs::Marker::ADD;
-
-              m.color.r = 1.0;
-              m.color.g = 0.0;
-              m.color.b = 0.0;
-              m.color.a = 1.0;
-              m.scale.x = 1;
-              m.scale.y = 0.01;
-              m.scale.z = 0.01;
-              m.lifetime.sec = 1;
-              m.lifetime.nsec = 0;
-
-              m.id = index;
-              float x = _normals[4 * index];
-              float y = _normals[4 * index + 1];
-              float z = _normals[4 * index + 2];
-
-              m.pose.position.x = pcd_[4 * index];
-              m.pose.position.y = pcd_[4 * index + 1];
-              m.pose.position.z = pcd_[4 * index + 2];
-
-              // calculating the angle of the normal with the world
-              tf::Vector3 axis_vector(x, y, z);
-              tf::Quaternion q = tf::Quaternion::getIdentity();
-              if (!axis_vector.isZero())
-              {
-                tf::Vector3 vector(1.0, 0.0, 0.0);
-                tf::Vector3 right_vector = axis_vector.cross(vector);
-                right_vector.normalized();
-                q.setRotation(right_vector, -1.0*acos(axis_vector.dot(vector)));
-                q.normalize();
-              }
-
-              m.pose.orientation.x = q.x();
-              m.pose.orientation.y = q.y();
-              m.pose.orientation.z = q.z();
-              m.pose.orientation.w = q.w();
-
-              m_array.markers.push_back(m);
-            }
-          }
-        }
-      }
-      this->normal_pub_.publish(m_array);
+        this->FillNormals(_normals, _width, _height);
     }
   }
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
 #endif
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Request the reflectance and normals buffers from the depth camera only
+// while they have subscribers
+void GazeboRosDepthCamera::UpdateAuxiliaryConnections()
+{
+  if (this->reflectance_connect_count_ > 0)
+  {
+    if (!this->newReflectanceFrameConnection)
+    {
+      this->newReflectanceFrameConnection =
+        this->depthCamera->ConnectNewReflectanceFrame(
+          std::bind(&GazeboRosDepthCamera::OnNewReflectanceFrame, this,
+            std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3, std::placeholders::_4,
+            std::placeholders::_5));
+    }
+  }
+  else
+    this->newReflectanceFrameConnection.reset();
+
+  if (this->normals_connect_count_ > 0)
+  {
+    if (!this->newNormalsFrameConnection)
+    {
+      this->newNormalsFrameConnection =
+        this->depthCamera->ConnectNewNormalsPointCloud(
+          std::bind(&GazeboRosDepthCamera::OnNewNormalsFrame, this,
+            std::placeholders::_1, std::placeholders::_2,
+            std::placeholders::_3, std::placeholders::_4,
+            std::placeholders::_5));
+    }
+  }
+  else
+    this->newNormalsFrameConnection.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Put normals with their points into a packed point cloud
+void GazeboRosDepthCamera::FillNormals(const float *_normals,
+  unsigned int _width, unsigned int _height)
+{
+  const unsigned int step = std::max(this->reduce_normals_, 1);
+  const unsigned int size = _width * _height;
+  const unsigned int count = (size + step - 1) / step;
+
+  sensor_msgs::PointCloud2Ptr normals_msg =
+    this->normals_pool_.acquire(count * 6 * sizeof(float));
+
+  normals_msg->header.frame_id = this->frame_name_;
+  normals_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  normals_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+
+  sensor_msgs::PointCloud2Modifier pcd_modifier(*normals_msg);
+  pcd_modifier.setPointCloud2Fields(6,
+    "x", 1, sensor_msgs::PointField::FLOAT32,
+    "y", 1, sensor_msgs::PointField::FLOAT32,
+    "z", 1, sensor_msgs::PointField::FLOAT32,
+    "normal_x", 1, sensor_msgs::PointField::FLOAT32,
+    "normal_y", 1, sensor_msgs::PointField::FLOAT32,
+    "normal_z", 1, sensor_msgs::PointField::FLOAT32);
+  pcd_modifier.resize(count);
+  normals_msg->is_dense = true;
+
+  // a plain strided copy: both inputs hold 4 floats per pixel, the output
+  // 6 floats per point
+  float *dst = reinterpret_cast<float*>(&normals_msg->data[0]);
+  const float *points = this->pcd_;
+  for (unsigned int k = 0; k < count; ++k)
+  {
+    const unsigned int index = 4 * k * step;
+    float *out = dst + 6 * k;
+    out[0] = points[index];
+    out[1] = points[index + 1];
+    out[2] = points[index + 2];
+    out[3] = _normals[index];
+    out[4] = _normals[index + 1];
+    out[5] = _normals[index + 2];
+  }
+
+  this->normal_pub_.publish(normals_msg);
+}
 #endif
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -581,21 +668,24 @@ void GazeboRosDepthCamera::FillPointdCloud(const float *_src)
 {
   this->lock_.lock();
 
-  this->point_cloud_msg_.header.frame_id = this->frame_name_;
-  this->point_cloud_msg_.header.stamp.sec = this->depth_sensor_update_time_.sec;
-  this->point_cloud_msg_.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
-  this->point_cloud_msg_.width = this->width;
-  this->point_cloud_msg_.height = this->height;
-  this->point_cloud_msg_.row_step = this->point_cloud_msg_.point_step * this->width;
+  sensor_msgs::PointCloud2Ptr point_cloud_msg =
+    this->point_cloud_pool_.acquire(this->width * this->height * 32);
+
+  point_cloud_msg->header.frame_id = this->frame_name_;
+  point_cloud_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  point_cloud_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+  point_cloud_msg->width = this->width;
+  point_cloud_msg->height = this->height;
+  point_cloud_msg->row_step = point_cloud_msg->point_step * this->width;
 
   ///copy from depth to point cloud message
-  FillPointCloudHelper(this->point_cloud_msg_,
+  FillPointCloudHelper(*point_cloud_msg,
                  this->height,
                  this->width,
                  this->skip_,
                  (void*)_src );
 
-  this->point_cloud_pub_.publish(this->point_cloud_msg_);
+  this->point_cloud_pub_.publish(point_cloud_msg);
 
   this->lock_.unlock();
 }
@@ -605,23 +695,67 @@ void GazeboRosDepthCamera::FillPointdCloud(const float *_src)
 void GazeboRosDepthCamera::FillDepthImage(const float *_src)
 {
   this->lock_.lock();
+
+  sensor_msgs::ImagePtr depth_image_msg =
+    this->depth_image_pool_.acquire(this->width * this->height * sizeof(float));
+
   // copy data into image
-  this->depth_image_msg_.header.frame_id = this->frame_name_;
-  this->depth_image_msg_.header.stamp.sec = this->depth_sensor_update_time_.sec;
-  this->depth_image_msg_.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+  depth_image_msg->header.frame_id = this->frame_name_;
+  depth_image_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  depth_image_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
 
   ///copy from depth to depth image message
-  FillDepthImageHelper(this->depth_image_msg_,
+  FillDepthImageHelper(*depth_image_msg,
                  this->height,
                  this->width,
                  this->skip_,
                  (void*)_src );
 
-  this->depth_image_pub_.publish(this->depth_image_msg_);
+  this->depth_image_pub_.publish(depth_image_msg);
 
   this->lock_.unlock();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+// Put disparity image data to the interface, similar to the openni driver
+void GazeboRosDepthCamera::FillDisparityImage(const float *_src)
+{
+  boost::mutex::scoped_lock lock(this->lock_);
+
+  stereo_msgs::DisparityImagePtr disparity_msg =
+    this->disparity_pool_.acquire(this->width * this->height * sizeof(float));
+
+  disparity_msg->header.frame_id = this->frame_name_;
+  disparity_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  disparity_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+  disparity_msg->image.header = disparity_msg->header;
+  disparity_msg->image.encoding = sensor_msgs::image_encodings::TYPE_32FC1;
+  disparity_msg->image.height = this->height;
+  disparity_msg->image.width = this->width;
+  disparity_msg->image.is_bigendian = 0;
+  disparity_msg->image.step = this->width * sizeof(float);
+  disparity_msg->image.data.resize(this->height * disparity_msg->image.step);
+
+  disparity_msg->T = this->disparity_baseline_;
+  disparity_msg->f = this->focal_length_;
+  disparity_msg->min_disparity = 0.0;
+  disparity_msg->max_disparity =
+    disparity_msg->T * disparity_msg->f / this->point_cloud_cutoff_;
+  disparity_msg->delta_d = 0.125;
+
+  // d = f * T / z, points in the unseeable range have no disparity
+  const float fT = disparity_msg->f * disparity_msg->T;
+  float *dest = reinterpret_cast<float*>(&disparity_msg->image.data[0]);
+  const unsigned int size = this->width * this->height;
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    float depth = _src[i];
+    dest[i] = depth > this->point_cloud_cutoff_ ? fT / depth : 0.0f;
+  }
+
+  this->disparity_pub_.publish(disparity_msg);
+}
+
 
 // Fill depth information
 bool GazeboRosDepthCamera::FillPointCloudHelper(
@@ -633,10 +767,10 @@ bool GazeboRosDepthCamera::FillPointCloudHelper(
   pcd_modifier.setPointCloud2FieldsByString(2, "xyz", "rgb");
   pcd_modifier.resize(rows_arg*cols_arg);
 
-  sensor_msgs::PointCloud2Iterator<float> iter_x(point_cloud_msg_, "x");
-  sensor_msgs::PointCloud2Iterator<float> iter_y(point_cloud_msg_, "y");
-  sensor_msgs::PointCloud2Iterator<float> iter_z(point_cloud_msg_, "z");
-  sensor_msgs::PointCloud2Iterator<uint8_t> iter_rgb(point_cloud_msg_, "rgb");
+  sensor_msgs::PointCloud2Iterator<float> iter_x(point_cloud_msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(point_cloud_msg, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(point_cloud_msg, "z");
+  sensor_msgs::PointCloud2Iterator<uint8_t> iter_rgb(point_cloud_msg, "rgb");
 
   point_cloud_msg.is_dense = true;
 
@@ -689,15 +823,16 @@ bool GazeboRosDepthCamera::FillPointCloudHelper(
       pcd_[4 * index + 3] = 0;
 
       // put image color data for each point
-      uint8_t*  image_src = (uint8_t*)(&(this->image_msg_.data[0]));
-      if (this->image_msg_.data.size() == rows_arg*cols_arg*3)
+      const size_t image_size = this->last_image_ ? this->last_image_->data.size() : 0;
+      const uint8_t* image_src = image_size ? &this->last_image_->data[0] : NULL;
+      if (image_size == rows_arg*cols_arg*3)
       {
         // color
         iter_rgb[0] = image_src[i*3+j*cols_arg*3+0];
         iter_rgb[1] = image_src[i*3+j*cols_arg*3+1];
         iter_rgb[2] = image_src[i*3+j*cols_arg*3+2];
       }
-      else if (this->image_msg_.data.size() == rows_arg*cols_arg)
+      else if (image_size == rows_arg*cols_arg)
       {
         // mono (or bayer?  @todo; fix for bayer)
         iter_rgb[0] = image_src[i+j*cols_arg];
@@ -799,35 +934,6 @@ void GazeboRosDepthCamera::PublishCameraInfo()
   }
 }
 
-//@todo: publish disparity similar to openni_camera_deprecated/src/nodelets/openni_nodelet.cpp.
-/*
-#include <stereo_msgs/DisparityImage.h>
-pub_disparity_ = comm_nh.advertise<stereo_msgs::DisparityImage > ("depth/disparity", 5, subscriberChanged2, subscriberChanged2);
-
-void GazeboRosDepthCamera::PublishDisparityImage(const DepthImage& depth, ros::Time time)
-{
-  stereo_msgs::DisparityImagePtr disp_msg = boost::make_shared<stereo_msgs::DisparityImage > ();
-  disp_msg->header.stamp                  = time;
-  disp_msg->header.frame_id               = device_->isDepthRegistered () ? rgb_frame_id_ : depth_frame_id_;
-  disp_msg->image.header                  = disp_msg->header;
-  disp_msg->image.encoding                = sensor_msgs::image_encodings::TYPE_32FC1;
-  disp_msg->image.height                  = depth_height_;
-  disp_msg->image.width                   = depth_width_;
-  disp_msg->image.step                    = disp_msg->image.width * sizeof (float);
-  disp_msg->image.data.resize (disp_msg->image.height * disp_msg->image.step);
-  disp_msg->T = depth.getBaseline ();
-  disp_msg->f = depth.getFocalLength () * depth_width_ / depth.getWidth ();
-
-  /// @todo Compute these values from DepthGenerator::GetDeviceMaxDepth() and the like
-  disp_msg->min_disparity = 0.0;
-  disp_msg->max_disparity = disp_msg->T * disp_msg->f / 0.3;
-  disp_msg->delta_d = 0.125;
-
-  depth.fillDisparityImage (depth_width_, depth_height_, reinterpret_cast<float*>(&disp_msg->image.data[0]), disp_msg->image.step);
-
-  pub_disparity_.publish (disp_msg);
-}
-*/
 
 
 }
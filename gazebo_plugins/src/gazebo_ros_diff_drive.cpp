@@ -51,6 +51,7 @@
 #include <assert.h>
 
 #include <gazebo_plugins/gazebo_ros_diff_drive.h>
+#include <gazebo_ros/joint_state_cache.h>
 
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
@@ -149,6 +150,16 @@ void GazeboRosDiffDrive::Load ( physics::ModelPtr _parent, sdf::ElementPtr _sdf
     {
         joint_state_publisher_ = gazebo_ros_->node()->advertise<sensor_msgs::JointState>("joint_states", 1000);
         ROS_INFO_NAMED("diff_drive", "%s: Advertise joint_states", gazebo_ros_->info());
+
+        // the wheels are read once per update for all plugins of the model
+        joint_state_cache_ = JointStateCache::Get ( parent );
+        joint_state_.name.resize ( joints_.size() );
+        joint_state_.position.resize ( joints_.size() );
+        joint_state_indices_.resize ( joints_.size() );
+        for ( std::size_t i = 0; i < joints_.size(); i++ ) {
+            joint_state_.name[i] = joints_[i]->GetName();
+            joint_state_indices_[i] = joint_state_cache_->Register ( joints_[i] );
+        }
     }
 
     transform_broadcaster_ = boost::shared_ptr<tf::TransformBroadcaster>(new tf::TransformBroadcaster());
@@ -201,18 +212,10 @@ void GazeboRosDiffDrive::publishWheelJointState()
     ros::Time current_time = ros::Time::now();
 
     joint_state_.header.stamp = current_time;
-    joint_state_.name.resize ( joints_.size() );
-    joint_state_.position.resize ( joints_.size() );
 
+    joint_state_cache_->Update();
     for ( int i = 0; i < 2; i++ ) {
-        physics::JointPtr joint = joints_[i];
-#if GAZEBO_MAJOR_VERSION >= 8
-        double position = joint->Position ( 0 );
-#else
-        double position = joint->GetAngle ( 0 ).Radian();
-#endif
-        joint_state_.name[i] = joint->GetName();
-        joint_state_.position[i] = position;
+        joint_state_.position[i] = joint_state_cache_->Position ( joint_state_indices_[i] );
     }
     joint_state_publisher_.publish ( joint_state_ );
 }
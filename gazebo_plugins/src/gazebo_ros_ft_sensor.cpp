@@ -21,6 +21,7 @@
  */
 
 #include <gazebo_plugins/gazebo_ros_ft_sensor.h>
+#include <gazebo_plugins/gazebo_ros_utils.h>
 #include <tf/tf.h>
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
@@ -79,6 +80,9 @@ void GazeboRosFT::Load( physics::ModelPtr _model, sdf::ElementPtr _sdf )
     return;
   }
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(this->noise_, _sdf, this->joint_->GetScopedName(), "FT");
+
   this->parent_link_ = this->joint_->GetParent();
   this->child_link_ = this->joint_->GetChild();
   this->frame_name_ = this->child_link_->GetName();
@@ -208,12 +212,12 @@ void GazeboRosFT::UpdateChild()
   this->wrench_msg_.header.stamp.nsec = (this->world_->GetSimTime()).nsec;
 #endif
 
-  this->wrench_msg_.wrench.force.x = force.X() + this->GaussianKernel(0, this->gaussian_noise_);
-  this->wrench_msg_.wrench.force.y = force.Y() + this->GaussianKernel(0, this->gaussian_noise_);
-  this->wrench_msg_.wrench.force.z = force.Z() + this->GaussianKernel(0, this->gaussian_noise_);
-  this->wrench_msg_.wrench.torque.x = torque.X() + this->GaussianKernel(0, this->gaussian_noise_);
-  this->wrench_msg_.wrench.torque.y = torque.Y() + this->GaussianKernel(0, this->gaussian_noise_);
-  this->wrench_msg_.wrench.torque.z = torque.Z() + this->GaussianKernel(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.force.x = force.X() + this->noise_.gaussian(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.force.y = force.Y() + this->noise_.gaussian(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.force.z = force.Z() + this->noise_.gaussian(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.torque.x = torque.X() + this->noise_.gaussian(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.torque.y = torque.Y() + this->noise_.gaussian(0, this->gaussian_noise_);
+  this->wrench_msg_.wrench.torque.z = torque.Z() + this->noise_.gaussian(0, this->gaussian_noise_);
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
   IGN_PROFILE_BEGIN("publish");
@@ -228,28 +232,6 @@ void GazeboRosFT::UpdateChild()
   this->last_time_ = cur_time;
 }
 
-//////////////////////////////////////////////////////////////////////////////
-// Utility for adding noise
-double GazeboRosFT::GaussianKernel(double mu, double sigma)
-{
-  // using Box-Muller transform to generate two independent standard
-  // normally disbributed normal variables see wikipedia
-
-  // normalized uniform random variable
-  double U = ignition::math::Rand::DblUniform();
-
-  // normalized uniform random variable
-  double V = ignition::math::Rand::DblUniform();
-
-  double X = sqrt(-2.0 * ::log(U)) * cos(2.0*M_PI * V);
-  // double Y = sqrt(-2.0 * ::log(U)) * sin(2.0*M_PI * V);
-
-  // there are 2 indep. vars, we'll just use X
-  // scale to our mu and sigma
-  X = sigma * X + mu;
-  return X;
-}
-
 // Custom Callback Queue
 ////////////////////////////////////////////////////////////////////////////////
 // custom callback queue thread
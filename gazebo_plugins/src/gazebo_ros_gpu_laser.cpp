@@ -22,6 +22,8 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 #include <string>
 #include <assert.h>
 
@@ -55,6 +57,7 @@ GZ_REGISTER_SENSOR_PLUGIN(GazeboRosLaser)
 // Constructor
 GazeboRosLaser::GazeboRosLaser()
 {
+  this->output_point_cloud2_ = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -104,6 +107,33 @@ void GazeboRosLaser::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->topic_name_ = this->sdf->Get<std::string>("topicName");
 
+  if (this->sdf->HasElement("outputType"))
+  {
+    std::string output_type = this->sdf->Get<std::string>("outputType");
+    if (output_type == "PointCloud2")
+      this->output_point_cloud2_ = true;
+    else if (output_type != "LaserScan")
+      ROS_WARN_NAMED("gpu_laser", "GazeboRosLaser plugin <outputType> [%s] unknown,"
+        " use LaserScan or PointCloud2. Defaults to LaserScan", output_type.c_str());
+  }
+
+  if (this->sdf->HasElement("pointCloud2Fields"))
+  {
+    std::string spec = this->sdf->Get<std::string>("pointCloud2Fields");
+    unsigned int fields;
+    if (PointCloud2Layout::parseFields(spec, fields))
+    {
+      // the simulated scan is instantaneous, every ray would get time 0
+      if (fields & PointCloud2Layout::TIME)
+        ROS_WARN_NAMED("gpu_laser", "GazeboRosLaser plugin <pointCloud2Fields> time is only written"
+          " by rolling scans, ignored");
+      this->cloud2_layout_.setFields(fields & ~PointCloud2Layout::TIME);
+    }
+    else
+      ROS_WARN_NAMED("gpu_laser", "GazeboRosLaser plugin <pointCloud2Fields> [%s] invalid,"
+        " use any of xyz, intensity, ring. Defaults to xyz intensity", spec.c_str());
+  }
+
   this->laser_connect_count_ = 0;
 
 
@@ -140,7 +170,18 @@ void GazeboRosLaser::LoadThread()
   // resolve tf prefix
   this->frame_name_ = tf::resolve(this->tf_prefix_, this->frame_name_);
 
-  if (this->topic_name_ != "")
+  if (this->topic_name_ != "" && this->output_point_cloud2_)
+  {
+    ros::AdvertiseOptions ao =
+      ros::AdvertiseOptions::create<sensor_msgs::PointCloud2>(
+      this->topic_name_, 1,
+      boost::bind(&GazeboRosLaser::LaserConnect, this),
+      boost::bind(&GazeboRosLaser::LaserDisconnect, this),
+      ros::VoidPtr(), NULL);
+    this->pub_ = this->rosnode_->advertise(ao);
+    this->cloud2_pub_queue_ = this->pmq.addPub<sensor_msgs::PointCloud2>();
+  }
+  else if (this->topic_name_ != "")
   {
     ros::AdvertiseOptions ao =
       ros::AdvertiseOptions::create<sensor_msgs::LaserScan>(
@@ -188,29 +229,105 @@ void GazeboRosLaser::OnScan(ConstLaserScanStampedPtr &_msg)
   IGN_PROFILE("GazeboRosLaser::OnScan");
   IGN_PROFILE_BEGIN("fill ROS message");
 #endif
-  // We got a new message from the Gazebo sensor.  Stuff a
-  // corresponding ROS message and publish it.
-  sensor_msgs::LaserScan laser_msg;
-  laser_msg.header.stamp = ros::Time(_msg->time().sec(), _msg->time().nsec());
-  laser_msg.header.frame_id = this->frame_name_;
-  laser_msg.angle_min = _msg->scan().angle_min();
-  laser_msg.angle_max = _msg->scan().angle_max();
-  laser_msg.angle_increment = _msg->scan().angle_step();
-  laser_msg.time_increment = 0;  // instantaneous simulator scan
-  laser_msg.scan_time = 0;  // not sure whether this is correct
-  laser_msg.range_min = _msg->scan().range_min();
-  laser_msg.range_max = _msg->scan().range_max();
-  laser_msg.ranges.resize(_msg->scan().ranges_size());
-  std::copy(_msg->scan().ranges().begin(),
-            _msg->scan().ranges().end(),
-            laser_msg.ranges.begin());
-  laser_msg.intensities.resize(_msg->scan().intensities_size());
-  std::copy(_msg->scan().intensities().begin(),
-            _msg->scan().intensities().end(),
-            laser_msg.intensities.begin());
+  // the Gazebo subscription is toggled from ROS callbacks on another
+  // thread, scans may still arrive after the last subscriber left
+  if (this->pub_.getNumSubscribers() == 0)
+  {
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    return;
+  }
+
+  if (this->output_point_cloud2_)
+  {
+    this->PublishPointCloud2(_msg);
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    return;
+  }
+
+  // We got a new message from the Gazebo sensor.  Stuff a pooled
+  // ROS message and hand it to the publisher queue without copying.
+  const msgs::LaserScan &scan = _msg->scan();
+  MessagePool<sensor_msgs::LaserScan>::MessagePtr laser_msg =
+    this->scan_pool_.acquire(scan.ranges_size() * sizeof(float));
+  laser_msg->header.stamp = ros::Time(_msg->time().sec(), _msg->time().nsec());
+  laser_msg->header.frame_id = this->frame_name_;
+  laser_msg->angle_min = scan.angle_min();
+  laser_msg->angle_max = scan.angle_max();
+  laser_msg->angle_increment = scan.angle_step();
+  laser_msg->time_increment = 0;  // instantaneous simulator scan
+  laser_msg->scan_time = 0;  // not sure whether this is correct
+  laser_msg->range_min = scan.range_min();
+  laser_msg->range_max = scan.range_max();
+  laser_msg->ranges.assign(scan.ranges().begin(), scan.ranges().end());
+  if (scan.intensities_size() == 0)
+    laser_msg->intensities.clear();
+  else
+    laser_msg->intensities.assign(scan.intensities().begin(),
+                                  scan.intensities().end());
   this->pub_queue_->push(laser_msg, this->pub_);
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
 #endif
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Convert a multi-ring Gazebo scan into a PointCloud2 and publish it
+void GazeboRosLaser::PublishPointCloud2(ConstLaserScanStampedPtr &_msg)
+{
+  const msgs::LaserScan &scan = _msg->scan();
+  const unsigned int count = scan.count();
+  const unsigned int vertical_count =
+    std::max(static_cast<unsigned int>(scan.vertical_count()), 1u);
+  if (!this->ray_tables_.update(scan))
+    return;
+
+  MessagePool<sensor_msgs::PointCloud2>::MessagePtr cloud2_msg =
+    this->cloud2_pool_.acquire(static_cast<size_t>(count) * vertical_count *
+                               this->cloud2_layout_.pointStep());
+  cloud2_msg->header.stamp = ros::Time(_msg->time().sec(), _msg->time().nsec());
+  cloud2_msg->header.frame_id = this->frame_name_;
+  this->cloud2_layout_.init(*cloud2_msg, count, vertical_count);
+
+  const float range_min = scan.range_min();
+  const float range_max = scan.range_max();
+  const bool has_intensities =
+    static_cast<unsigned int>(scan.intensities_size()) >= count * vertical_count;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  bool dense = true;
+
+  // one row per ring, ranges are stored ring by ring starting at the lowest
+  for (unsigned int j = 0; j < vertical_count; ++j)
+  {
+    uint8_t *row = &cloud2_msg->data[j * cloud2_msg->row_step];
+    const float cos_pitch = this->ray_tables_.cosPitch(j);
+    const float sin_pitch = this->ray_tables_.sinPitch(j);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      const unsigned int index = j * count + i;
+      const float r = scan.ranges(index);
+      const float intensity = has_intensities ? scan.intensities(index) : 0.0f;
+
+      // rays without a return are kept as NaN to keep the cloud organized
+      float x = nan, y = nan, z = nan;
+      if (r >= range_min && r <= range_max)
+      {
+        x = r * cos_pitch * this->ray_tables_.cosYaw(i);
+        y = r * cos_pitch * this->ray_tables_.sinYaw(i);
+        z = r * sin_pitch;
+      }
+      else
+        dense = false;
+
+      this->cloud2_layout_.write(row + i * cloud2_msg->point_step,
+        x, y, z, intensity, j, 0.0f);
+    }
+  }
+  cloud2_msg->is_dense = dense;
+
+  this->cloud2_pub_queue_->push(cloud2_msg, this->pub_);
+}
 }
@@ -21,6 +21,7 @@
  */
 
 #include <gazebo_plugins/gazebo_ros_imu.h>
+#include <gazebo_plugins/gazebo_ros_utils.h>
 #include <ignition/math/Rand.hh>
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
@@ -162,6 +163,9 @@ void GazeboRosIMU::LoadThread()
     return;
   }
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(this->noise_, this->sdf, this->link->GetScopedName(), "Imu");
+
   // if topic name specified as empty, do not publish
   if (this->topic_name_ != "")
   {
@@ -295,9 +299,9 @@ void GazeboRosIMU::UpdateChild()
 
     // pass euler angular rates
     ignition::math::Vector3d linear_velocity(
-      veul.X() + this->GaussianKernel(0, this->gaussian_noise_),
-      veul.Y() + this->GaussianKernel(0, this->gaussian_noise_),
-      veul.Z() + this->GaussianKernel(0, this->gaussian_noise_));
+      veul.X() + this->noise_.gaussian(0, this->gaussian_noise_),
+      veul.Y() + this->noise_.gaussian(0, this->gaussian_noise_),
+      veul.Z() + this->noise_.gaussian(0, this->gaussian_noise_));
     // rotate into local frame
     // @todo: deal with offsets!
     linear_velocity = rot.RotateVector(linear_velocity);
@@ -307,9 +311,9 @@ void GazeboRosIMU::UpdateChild()
 
     // pass accelerations
     ignition::math::Vector3d linear_acceleration(
-      apos_.X() + this->GaussianKernel(0, this->gaussian_noise_),
-      apos_.Y() + this->GaussianKernel(0, this->gaussian_noise_),
-      apos_.Z() + this->GaussianKernel(0, this->gaussian_noise_));
+      apos_.X() + this->noise_.gaussian(0, this->gaussian_noise_),
+      apos_.Y() + this->noise_.gaussian(0, this->gaussian_noise_),
+      apos_.Z() + this->noise_.gaussian(0, this->gaussian_noise_));
     // rotate into local frame
     // @todo: deal with offsets!
     linear_acceleration = rot.RotateVector(linear_acceleration);
@@ -347,28 +351,6 @@ void GazeboRosIMU::UpdateChild()
 }
 
 
-//////////////////////////////////////////////////////////////////////////////
-// Utility for adding noise
-double GazeboRosIMU::GaussianKernel(double mu, double sigma)
-{
-  // using Box-Muller transform to generate two independent standard
-  // normally disbributed normal variables see wikipedia
-
-  // normalized uniform random variable
-  double U = ignition::math::Rand::DblUniform();
-
-  // normalized uniform random variable
-  double V = ignition::math::Rand::DblUniform();
-
-  double X = sqrt(-2.0 * ::log(U)) * cos(2.0*M_PI * V);
-  // double Y = sqrt(-2.0 * ::log(U)) * sin(2.0*M_PI * V);
-
-  // there are 2 indep. vars, we'll just use X
-  // scale to our mu and sigma
-  X = sigma * X + mu;
-  return X;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 // Put laser data to the interface
 void GazeboRosIMU::IMUQueueThread()
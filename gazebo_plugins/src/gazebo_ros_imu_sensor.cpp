@@ -15,6 +15,7 @@
  * limitations under the License.*/
 
 #include <gazebo_plugins/gazebo_ros_imu_sensor.h>
+#include <gazebo_plugins/gazebo_ros_utils.h>
 #include <iostream>
 #include <gazebo/sensors/ImuSensor.hh>
 #include <gazebo/physics/World.hh>
@@ -44,6 +45,9 @@ void gazebo::GazeboRosImuSensor::Load(gazebo::sensors::SensorPtr sensor_, sdf::E
     return;
   }
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(noise, sdf, sensor->ScopedName(), "ImuSensor");
+
   bool initial_orientation_as_reference = false;
   if (!sdf->HasElement("initialOrientationAsReference"))
   {
@@ -109,18 +113,18 @@ void gazebo::GazeboRosImuSensor::UpdateChild(const gazebo::common::UpdateInfo &/
     gyroscope_data = sensor->AngularVelocity();
 
     //Guassian noise is applied to all measurements
-    imu_msg.orientation.x = orientation.X() + GuassianKernel(0,gaussian_noise);
-    imu_msg.orientation.y = orientation.Y() + GuassianKernel(0,gaussian_noise);
-    imu_msg.orientation.z = orientation.Z() + GuassianKernel(0,gaussian_noise);
-    imu_msg.orientation.w = orientation.W() + GuassianKernel(0,gaussian_noise);
+    imu_msg.orientation.x = orientation.X() + noise.gaussian(0,gaussian_noise);
+    imu_msg.orientation.y = orientation.Y() + noise.gaussian(0,gaussian_noise);
+    imu_msg.orientation.z = orientation.Z() + noise.gaussian(0,gaussian_noise);
+    imu_msg.orientation.w = orientation.W() + noise.gaussian(0,gaussian_noise);
 
-    imu_msg.linear_acceleration.x = accelerometer_data.X() + GuassianKernel(0,gaussian_noise);
-    imu_msg.linear_acceleration.y = accelerometer_data.Y() + GuassianKernel(0,gaussian_noise);
-    imu_msg.linear_acceleration.z = accelerometer_data.Z() + GuassianKernel(0,gaussian_noise);
+    imu_msg.linear_acceleration.x = accelerometer_data.X() + noise.gaussian(0,gaussian_noise);
+    imu_msg.linear_acceleration.y = accelerometer_data.Y() + noise.gaussian(0,gaussian_noise);
+    imu_msg.linear_acceleration.z = accelerometer_data.Z() + noise.gaussian(0,gaussian_noise);
 
-    imu_msg.angular_velocity.x = gyroscope_data.X() + GuassianKernel(0,gaussian_noise);
-    imu_msg.angular_velocity.y = gyroscope_data.Y() + GuassianKernel(0,gaussian_noise);
-    imu_msg.angular_velocity.z = gyroscope_data.Z() + GuassianKernel(0,gaussian_noise);
+    imu_msg.angular_velocity.x = gyroscope_data.X() + noise.gaussian(0,gaussian_noise);
+    imu_msg.angular_velocity.y = gyroscope_data.Y() + noise.gaussian(0,gaussian_noise);
+    imu_msg.angular_velocity.z = gyroscope_data.Z() + noise.gaussian(0,gaussian_noise);
 
     //covariance is related to the Gaussian noise
     double gn2 = gaussian_noise*gaussian_noise;
@@ -153,20 +157,6 @@ void gazebo::GazeboRosImuSensor::UpdateChild(const gazebo::common::UpdateInfo &/
   last_time = current_time;
 }
 
-double gazebo::GazeboRosImuSensor::GuassianKernel(double mu, double sigma)
-{
-  // generation of two normalized uniform random variables
-  double U1 = ignition::math::Rand::DblUniform();
-  double U2 = ignition::math::Rand::DblUniform();
-
-  // using Box-Muller transform to obtain a varaible with a standard normal distribution
-  double Z0 = sqrt(-2.0 * ::log(U1)) * cos(2.0*M_PI * U2);
-
-  // scaling
-  Z0 = sigma * Z0 + mu;
-  return Z0;
-}
-
 bool gazebo::GazeboRosImuSensor::LoadParameters()
 {
   //loading parameters from the sdf file
@@ -26,7 +26,9 @@
  *
  **/
 #include <boost/algorithm/string.hpp>
+#include <boost/lexical_cast.hpp>
 #include <gazebo_plugins/gazebo_ros_joint_state_publisher.h>
+#include <gazebo_ros/joint_state_cache.h>
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
 #endif
@@ -35,10 +37,16 @@
 
 using namespace gazebo;
 
-GazeboRosJointStatePublisher::GazeboRosJointStatePublisher() {}
+GazeboRosJointStatePublisher::GazeboRosJointStatePublisher() : publishing_ ( false ), dropped_ ( 0 ) {}
 
 // Destructor
 GazeboRosJointStatePublisher::~GazeboRosJointStatePublisher() {
+    this->updateConnection.reset();
+    if ( publisher_thread_.joinable() ) {
+        publishing_ = false;
+        publisher_cond_.notify_one();
+        publisher_thread_.join();
+    }
     rosnode_->shutdown();
 }
 
@@ -75,32 +83,71 @@ void GazeboRosJointStatePublisher::Load ( physics::ModelPtr _parent, sdf::Elemen
         this->update_rate_ = _sdf->GetElement ( "updateRate" )->Get<double>();
     }
 
+    int queue_size = 16;
+    if ( _sdf->HasElement ( "queueSize" ) ) {
+        queue_size = _sdf->GetElement ( "queueSize" )->Get<int>();
+        if ( queue_size < 2 ) {
+            ROS_WARN_NAMED("joint_state_publisher", "GazeboRosJointStatePublisher Plugin (ns = %s) <queueSize> %d is below 2, using 2",
+                       this->robot_namespace_.c_str(), queue_size );
+            queue_size = 2;
+        }
+    }
+
     // Initialize update rate stuff
     if ( this->update_rate_ > 0.0 ) {
         this->update_period_ = 1.0 / this->update_rate_;
     } else {
         this->update_period_ = 0.0;
     }
-#if GAZEBO_MAJOR_VERSION >= 8
-    last_update_time_ = this->world_->SimTime();
-#else
-    last_update_time_ = this->world_->GetSimTime();
-#endif
 
     for ( unsigned int i = 0; i< joint_names_.size(); i++ ) {
         physics::JointPtr joint = this->parent_->GetJoint(joint_names_[i]);
         if (!joint) {
             ROS_FATAL_NAMED("joint_state_publisher", "Joint %s does not exist!", joint_names_[i].c_str());
+            continue;
         }
         joints_.push_back ( joint );
         ROS_INFO_NAMED("joint_state_publisher", "GazeboRosJointStatePublisher is going to publish joint: %s", joint_names_[i].c_str() );
     }
 
+    // one entry per axis, the names never change
+    joint_state_cache_ = JointStateCache::Get ( parent_ );
+    std::vector<std::string> names;
+    for ( unsigned int i = 0; i < joints_.size(); i++ ) {
+#if GAZEBO_MAJOR_VERSION >= 8
+        unsigned int dof = joints_[i]->DOF();
+#else
+        unsigned int dof = joints_[i]->GetAngleCount();
+#endif
+        for ( unsigned int axis = 0; axis < dof; axis++ ) {
+            cache_indices_.push_back ( joint_state_cache_->Register ( joints_[i], axis ) );
+            if ( axis == 0 ) {
+                names.push_back ( joints_[i]->GetName() );
+            } else {
+                names.push_back ( joints_[i]->GetName() + "_" + boost::lexical_cast<std::string> ( axis ) );
+            }
+        }
+    }
+
+    joint_states_.resize ( queue_size );
+    free_.reset ( new boost::lockfree::spsc_queue<unsigned int> ( queue_size ) );
+    ready_.reset ( new boost::lockfree::spsc_queue<unsigned int> ( queue_size ) );
+    for ( int i = 0; i < queue_size; i++ ) {
+        joint_states_[i].name = names;
+        joint_states_[i].position.resize ( names.size() );
+        joint_states_[i].velocity.resize ( names.size() );
+        joint_states_[i].effort.resize ( names.size() );
+        free_->push ( i );
+    }
+
     ROS_INFO_NAMED("joint_state_publisher", "Starting GazeboRosJointStatePublisher Plugin (ns = %s)!, parent name: %s", this->robot_namespace_.c_str(), parent_->GetName ().c_str() );
 
     tf_prefix_ = tf::getPrefixParam ( *rosnode_ );
     joint_state_publisher_ = rosnode_->advertise<sensor_msgs::JointState> ( "joint_states",1000 );
 
+    publishing_ = true;
+    publisher_thread_ = boost::thread ( boost::bind ( &GazeboRosJointStatePublisher::publisherThread, this ) );
+
 #if GAZEBO_MAJOR_VERSION >= 8
     last_update_time_ = this->world_->SimTime();
 #else
@@ -115,14 +162,9 @@ void GazeboRosJointStatePublisher::Load ( physics::ModelPtr _parent, sdf::Elemen
 void GazeboRosJointStatePublisher::OnUpdate ( const common::UpdateInfo & _info )
 {
 #ifdef ENABLE_PROFILER
-  IGN_PROFILE("GazeboRosCamera::OnNewFrame");
-#endif
-    // Apply a small linear velocity to the model.
-#if GAZEBO_MAJOR_VERSION >= 8
-    common::Time current_time = this->world_->SimTime();
-#else
-    common::Time current_time = this->world_->GetSimTime();
+  IGN_PROFILE("GazeboRosJointStatePublisher::OnUpdate");
 #endif
+    common::Time current_time = _info.simTime;
     if (current_time < last_update_time_)
     {
         ROS_WARN_NAMED("joint_state_publisher", "Negative joint state update time difference detected.");
@@ -132,37 +174,63 @@ void GazeboRosJointStatePublisher::OnUpdate ( const common::UpdateInfo & _info )
     double seconds_since_last_update = ( current_time - last_update_time_ ).Double();
 
     if ( seconds_since_last_update > update_period_ ) {
+        if ( joint_state_publisher_.getNumSubscribers() > 0 ) {
 #ifdef ENABLE_PROFILER
-        IGN_PROFILE_BEGIN("publishJointStates");
+            IGN_PROFILE_BEGIN("publishJointStates");
 #endif
-        publishJointStates();
+            publishJointStates ( current_time );
 #ifdef ENABLE_PROFILER
-        IGN_PROFILE_END();
+            IGN_PROFILE_END();
 #endif
+        }
         last_update_time_+= common::Time ( update_period_ );
     }
 
 }
 
-void GazeboRosJointStatePublisher::publishJointStates() {
-    ros::Time current_time = ros::Time::now();
+void GazeboRosJointStatePublisher::publishJointStates ( const common::Time &_stamp ) {
+    unsigned int slot;
+    if ( !free_->pop ( slot ) ) {
+        // the publisher thread is behind, keep the states already queued
+        ++dropped_;
+        ROS_WARN_THROTTLE_NAMED(10, "joint_state_publisher", "GazeboRosJointStatePublisher (ns = %s) dropped %u joint states, the publisher thread can not keep up",
+                   this->robot_namespace_.c_str(), dropped_ );
+        return;
+    }
 
-    joint_state_.header.stamp = current_time;
-    joint_state_.name.resize ( joints_.size() );
-    joint_state_.position.resize ( joints_.size() );
-    joint_state_.velocity.resize ( joints_.size() );
+    sensor_msgs::JointState &joint_state = joint_states_[slot];
+    joint_state.header.stamp = ros::Time ( _stamp.sec, _stamp.nsec );
 
-    for ( int i = 0; i < joints_.size(); i++ ) {
-        physics::JointPtr joint = joints_[i];
-        double velocity = joint->GetVelocity( 0 );
-#if GAZEBO_MAJOR_VERSION >= 8
-        double position = joint->Position ( 0 );
-#else
-        double position = joint->GetAngle ( 0 ).Radian();
-#endif
-        joint_state_.name[i] = joint->GetName();
-        joint_state_.position[i] = position;
-        joint_state_.velocity[i] = velocity;
+    joint_state_cache_->Update();
+    const size_t n = cache_indices_.size();
+    for ( size_t i = 0; i < n; i++ ) {
+        const unsigned int index = cache_indices_[i];
+        joint_state.position[i] = joint_state_cache_->Position ( index );
+        joint_state.velocity[i] = joint_state_cache_->Velocity ( index );
+        joint_state.effort[i] = joint_state_cache_->Effort ( index );
+    }
+
+    ready_->push ( slot );
+    // the publisher thread also wakes up on its own, a notification lost
+    // while it is about to wait only delays the state
+    publisher_cond_.notify_one();
+}
+
+void GazeboRosJointStatePublisher::publisherThread() {
+    // wait at most one update period, or 1 ms without an update rate
+    const boost::posix_time::time_duration timeout =
+        boost::posix_time::microseconds ( update_period_ > 0.001 ? static_cast<long> ( update_period_ * 1e6 ) : 1000 );
+
+    unsigned int slot;
+    while ( publishing_ ) {
+        while ( ready_->pop ( slot ) ) {
+            joint_state_publisher_.publish ( joint_states_[slot] );
+            free_->push ( slot );
+        }
+
+        boost::mutex::scoped_lock lock ( publisher_mutex_ );
+        if ( publishing_ && ready_->empty() ) {
+            publisher_cond_.timed_wait ( lock, timeout );
+        }
     }
-    joint_state_publisher_.publish ( joint_state_ );
 }
@@ -22,6 +22,9 @@
  */
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
 #include <string>
 #include <assert.h>
 
@@ -33,6 +36,7 @@
 #include <gazebo/common/Exception.hh>
 #include <gazebo/sensors/RaySensor.hh>
 #include <gazebo/sensors/SensorTypes.hh>
+#include <gazebo/msgs/msgs.hh>
 #include <gazebo/transport/transport.hh>
 
 #ifdef ENABLE_PROFILER
@@ -53,6 +57,10 @@ GZ_REGISTER_SENSOR_PLUGIN(GazeboRosLaser)
 ////////////////////////////////////////////////////////////////////////////////
 // Constructor
 GazeboRosLaser::GazeboRosLaser()
+  : assembled_next_(0), assembled_period_(0.0),
+    rolling_layout_(PointCloud2Layout::XYZ | PointCloud2Layout::INTENSITY |
+                    PointCloud2Layout::RING | PointCloud2Layout::TIME),
+    rolling_has_last_(false), rolling_max_period_(0.0)
 {
 }
 
@@ -102,6 +110,47 @@ void GazeboRosLaser::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->topic_name_ = this->sdf->Get<std::string>("topicName");
 
+  // optional cloud of the last scans in a fixed frame
+  if (this->sdf->HasElement("assembledTopicName"))
+    this->assembled_topic_name_ = this->sdf->Get<std::string>("assembledTopicName");
+
+  if (!this->sdf->HasElement("assembledFrameName"))
+    this->assembled_frame_name_ = "world";
+  else
+    this->assembled_frame_name_ = this->sdf->Get<std::string>("assembledFrameName");
+
+  unsigned int assembled_scans = 10;
+  if (this->sdf->HasElement("assembledScans"))
+    assembled_scans = std::max(this->sdf->Get<unsigned int>("assembledScans"), 1u);
+  this->assembled_scans_.resize(assembled_scans);
+
+  double assembled_rate = 1.0;
+  if (this->sdf->HasElement("assembledUpdateRate"))
+    assembled_rate = this->sdf->Get<double>("assembledUpdateRate");
+  this->assembled_period_ = assembled_rate > 0.0 ? 1.0/assembled_rate : 0.0;
+
+  // optional cloud simulating the motion distortion of a rotating sensor
+  if (this->sdf->HasElement("rollingScanTopicName"))
+    this->rolling_topic_name_ = this->sdf->Get<std::string>("rollingScanTopicName");
+
+  if (this->sdf->HasElement("pointCloud2Fields"))
+  {
+    std::string spec = this->sdf->Get<std::string>("pointCloud2Fields");
+    unsigned int fields;
+    if (PointCloud2Layout::parseFields(spec, fields))
+      this->rolling_layout_.setFields(fields);
+    else
+      ROS_WARN_NAMED("laser", "Laser plugin <pointCloud2Fields> [%s] invalid,"
+        " use any of xyz, intensity, ring, time. Defaults to all", spec.c_str());
+  }
+
+  // one sweep lasts one sensor update period, longer gaps mean scans were
+  // skipped and the motion in between is unknown
+  if (this->parent_ray_sensor_->UpdateRate() > 0.0)
+    this->rolling_max_period_ = 1.5 / this->parent_ray_sensor_->UpdateRate();
+  else
+    this->rolling_max_period_ = std::numeric_limits<double>::max();
+
   this->laser_connect_count_ = 0;
 
     // Make sure the ROS node for Gazebo has already been initialized
@@ -149,6 +198,31 @@ void GazeboRosLaser::LoadThread()
     this->pub_queue_ = this->pmq.addPub<sensor_msgs::LaserScan>();
   }
 
+  if (this->assembled_topic_name_ != "")
+  {
+    // shares the connection count, scans are needed by either output
+    ros::AdvertiseOptions ao =
+      ros::AdvertiseOptions::create<sensor_msgs::PointCloud2>(
+      this->assembled_topic_name_, 1,
+      boost::bind(&GazeboRosLaser::LaserConnect, this),
+      boost::bind(&GazeboRosLaser::LaserDisconnect, this),
+      ros::VoidPtr(), NULL);
+    this->assembled_pub_ = this->rosnode_->advertise(ao);
+    this->assembled_pub_queue_ = this->pmq.addPub<sensor_msgs::PointCloud2>();
+  }
+
+  if (this->rolling_topic_name_ != "")
+  {
+    ros::AdvertiseOptions ao =
+      ros::AdvertiseOptions::create<sensor_msgs::PointCloud2>(
+      this->rolling_topic_name_, 1,
+      boost::bind(&GazeboRosLaser::LaserConnect, this),
+      boost::bind(&GazeboRosLaser::LaserDisconnect, this),
+      ros::VoidPtr(), NULL);
+    this->rolling_pub_ = this->rosnode_->advertise(ao);
+    this->rolling_pub_queue_ = this->pmq.addPub<sensor_msgs::PointCloud2>();
+  }
+
   // Initialize the controller
 
   // sensor generation off by default
@@ -183,29 +257,275 @@ void GazeboRosLaser::OnScan(ConstLaserScanStampedPtr &_msg)
   IGN_PROFILE("GazeboRosLaser::OnScan");
   IGN_PROFILE_BEGIN("fill ROS message");
 #endif
-  // We got a new message from the Gazebo sensor.  Stuff a
-  // corresponding ROS message and publish it.
-  sensor_msgs::LaserScan laser_msg;
-  laser_msg.header.stamp = ros::Time(_msg->time().sec(), _msg->time().nsec());
-  laser_msg.header.frame_id = this->frame_name_;
-  laser_msg.angle_min = _msg->scan().angle_min();
-  laser_msg.angle_max = _msg->scan().angle_max();
-  laser_msg.angle_increment = _msg->scan().angle_step();
-  laser_msg.time_increment = 0;  // instantaneous simulator scan
-  laser_msg.scan_time = 0;  // not sure whether this is correct
-  laser_msg.range_min = _msg->scan().range_min();
-  laser_msg.range_max = _msg->scan().range_max();
-  laser_msg.ranges.resize(_msg->scan().ranges_size());
-  std::copy(_msg->scan().ranges().begin(),
-            _msg->scan().ranges().end(),
-            laser_msg.ranges.begin());
-  laser_msg.intensities.resize(_msg->scan().intensities_size());
-  std::copy(_msg->scan().intensities().begin(),
-            _msg->scan().intensities().end(),
-            laser_msg.intensities.begin());
+  if (this->assembled_pub_.getNumSubscribers() > 0)
+    this->AssembleScan(_msg);
+
+  if (this->rolling_pub_.getNumSubscribers() > 0)
+    this->PublishRollingScan(_msg);
+  else
+    this->rolling_has_last_ = false;
+
+  // the Gazebo subscription is toggled from ROS callbacks on another
+  // thread, scans may still arrive after the last subscriber left
+  if (this->pub_.getNumSubscribers() == 0)
+  {
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    return;
+  }
+
+  // We got a new message from the Gazebo sensor.  Stuff a pooled
+  // ROS message and hand it to the publisher queue without copying.
+  const msgs::LaserScan &scan = _msg->scan();
+  MessagePool<sensor_msgs::LaserScan>::MessagePtr laser_msg =
+    this->scan_pool_.acquire(scan.ranges_size() * sizeof(float));
+  laser_msg->header.stamp = ros::Time(_msg->time().sec(), _msg->time().nsec());
+  laser_msg->header.frame_id = this->frame_name_;
+  laser_msg->angle_min = scan.angle_min();
+  laser_msg->angle_max = scan.angle_max();
+  laser_msg->angle_increment = scan.angle_step();
+  laser_msg->time_increment = 0;  // instantaneous simulator scan
+  laser_msg->scan_time = 0;  // not sure whether this is correct
+  laser_msg->range_min = scan.range_min();
+  laser_msg->range_max = scan.range_max();
+  laser_msg->ranges.assign(scan.ranges().begin(), scan.ranges().end());
+  if (scan.intensities_size() == 0)
+    laser_msg->intensities.clear();
+  else
+    laser_msg->intensities.assign(scan.intensities().begin(),
+                                  scan.intensities().end());
   this->pub_queue_->push(laser_msg, this->pub_);
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
 #endif
 }
+
+////////////////////////////////////////////////////////////////////////////////
+// Project a scan into the fixed frame and add it to the ring of scans
+void GazeboRosLaser::AssembleScan(ConstLaserScanStampedPtr &_msg)
+{
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_BEGIN("assemble scan");
+#endif
+  const msgs::LaserScan &scan = _msg->scan();
+  const unsigned int count = scan.count();
+  const unsigned int vertical_count =
+    std::max(static_cast<unsigned int>(scan.vertical_count()), 1u);
+  if (this->ray_tables_.update(scan))
+  {
+    // the scan carries the sensor pose at capture time, so no tf lookup
+    // is needed to place it in the world
+    const ignition::math::Pose3d pose = msgs::ConvertIgn(scan.world_pose());
+    const ignition::math::Matrix3d rot(pose.Rot());
+    const float m00 = rot(0, 0), m01 = rot(0, 1), m02 = rot(0, 2);
+    const float m10 = rot(1, 0), m11 = rot(1, 1), m12 = rot(1, 2);
+    const float m20 = rot(2, 0), m21 = rot(2, 1), m22 = rot(2, 2);
+    const float tx = pose.Pos().X(), ty = pose.Pos().Y(), tz = pose.Pos().Z();
+
+    const float range_min = scan.range_min();
+    const float range_max = scan.range_max();
+    const bool has_intensities =
+      static_cast<unsigned int>(scan.intensities_size()) >= count * vertical_count;
+
+    std::vector<float> &points = this->assembled_scans_[this->assembled_next_];
+    points.resize(4 * count * vertical_count);
+    float *out = points.empty() ? NULL : &points[0];
+    size_t n = 0;
+    for (unsigned int j = 0; j < vertical_count; ++j)
+    {
+      const float cos_pitch = this->ray_tables_.cosPitch(j);
+      const float sin_pitch = this->ray_tables_.sinPitch(j);
+      for (unsigned int i = 0; i < count; ++i)
+      {
+        const unsigned int index = j * count + i;
+        const float r = scan.ranges(index);
+        // rays without a return are dropped
+        if (!(r >= range_min && r <= range_max))
+          continue;
+
+        const float lx = r * cos_pitch * this->ray_tables_.cosYaw(i);
+        const float ly = r * cos_pitch * this->ray_tables_.sinYaw(i);
+        const float lz = r * sin_pitch;
+        out[n++] = m00 * lx + m01 * ly + m02 * lz + tx;
+        out[n++] = m10 * lx + m11 * ly + m12 * lz + ty;
+        out[n++] = m20 * lx + m21 * ly + m22 * lz + tz;
+        out[n++] = has_intensities ? scan.intensities(index) : 0.0f;
+      }
+    }
+    points.resize(n);
+    this->assembled_next_ = (this->assembled_next_ + 1) % this->assembled_scans_.size();
+  }
+
+  const ros::Time stamp(_msg->time().sec(), _msg->time().nsec());
+  if (stamp < this->last_assembled_time_)
+    this->last_assembled_time_ = stamp;
+  if ((stamp - this->last_assembled_time_).toSec() >= this->assembled_period_)
+  {
+    this->PublishAssembledCloud(stamp);
+    this->last_assembled_time_ = stamp;
+  }
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_END();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Publish the ring of assembled scans as one PointCloud2
+void GazeboRosLaser::PublishAssembledCloud(const ros::Time &_stamp)
+{
+  size_t num_floats = 0;
+  for (size_t k = 0; k < this->assembled_scans_.size(); ++k)
+    num_floats += this->assembled_scans_[k].size();
+
+  // the stored points already have the x, y, z, intensity layout
+  static const PointCloud2Layout layout(
+    PointCloud2Layout::XYZ | PointCloud2Layout::INTENSITY);
+  MessagePool<sensor_msgs::PointCloud2>::MessagePtr cloud =
+    this->assembled_pool_.acquire(num_floats * sizeof(float));
+  cloud->header.stamp = _stamp;
+  cloud->header.frame_id = this->assembled_frame_name_;
+  layout.init(*cloud, num_floats / 4, 1);
+  cloud->is_dense = true;
+
+  // oldest scan first
+  uint8_t *data = cloud->data.empty() ? NULL : &cloud->data[0];
+  for (size_t k = 0; k < this->assembled_scans_.size(); ++k)
+  {
+    const std::vector<float> &points = this->assembled_scans_[
+      (this->assembled_next_ + k) % this->assembled_scans_.size()];
+    if (points.empty())
+      continue;
+    memcpy(data, &points[0], points.size() * sizeof(float));
+    data += points.size() * sizeof(float);
+  }
+
+  this->assembled_pub_queue_->push(cloud, this->assembled_pub_);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Publish the scan distorted like the scan of a rotating sensor
+void GazeboRosLaser::PublishRollingScan(ConstLaserScanStampedPtr &_msg)
+{
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_BEGIN("rolling scan");
+#endif
+  const msgs::LaserScan &scan = _msg->scan();
+  const ros::Time stamp(_msg->time().sec(), _msg->time().nsec());
+  const ignition::math::Pose3d pose = msgs::ConvertIgn(scan.world_pose());
+
+  // Gazebo casts all rays at once from the pose at the end of the sweep.
+  // A rotating sensor casts column i at a fraction i / count of the sweep,
+  // from a pose interpolated between the previous and the current scan.
+  // Each point is expressed in the frame of the sensor at its own capture
+  // time, which with D the motion over the sweep and s the share of the
+  // sweep still ahead of the ray is D^s applied to the undistorted point.
+  // D^s interpolates the rotation about its axis and the translation
+  // linearly, which is exact for constant velocity without coupling.
+  double sweep = 0.0;
+  ignition::math::Vector3d axis(1, 0, 0), translation;
+  double angle = 0.0;
+  if (this->rolling_has_last_)
+  {
+    sweep = (stamp - this->rolling_last_time_).toSec();
+    if (sweep > 0.0 && sweep <= this->rolling_max_period_)
+    {
+      const ignition::math::Quaterniond inv = this->rolling_last_pose_.Rot().Inverse();
+      (inv * pose.Rot()).ToAxis(axis, angle);
+      translation = inv.RotateVector(pose.Pos() - this->rolling_last_pose_.Pos());
+    }
+    else
+      sweep = 0.0;
+  }
+  this->rolling_last_pose_ = pose;
+  this->rolling_last_time_ = stamp;
+  this->rolling_has_last_ = true;
+
+  if (!this->ray_tables_.update(scan))
+  {
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    return;
+  }
+
+  const unsigned int count = scan.count();
+  const unsigned int vertical_count =
+    std::max(static_cast<unsigned int>(scan.vertical_count()), 1u);
+
+  // per column share of the remaining sweep and its rotation
+  this->rolling_share_.resize(count);
+  this->rolling_cos_.resize(count);
+  this->rolling_sin_.resize(count);
+  for (unsigned int i = 0; i < count; ++i)
+  {
+    const double share = sweep > 0.0 ? 1.0 - static_cast<double>(i) / count : 0.0;
+    this->rolling_share_[i] = share;
+    this->rolling_cos_[i] = cos(share * angle);
+    this->rolling_sin_[i] = sin(share * angle);
+  }
+
+  MessagePool<sensor_msgs::PointCloud2>::MessagePtr cloud =
+    this->rolling_pool_.acquire(static_cast<size_t>(count) * vertical_count *
+                                this->rolling_layout_.pointStep());
+  // the header marks the start of the sweep, the time field the offset of
+  // each column
+  cloud->header.stamp = stamp - ros::Duration(sweep);
+  cloud->header.frame_id = this->frame_name_;
+  this->rolling_layout_.init(*cloud, count, vertical_count);
+
+  const float ux = axis.X(), uy = axis.Y(), uz = axis.Z();
+  const float vx = translation.X(), vy = translation.Y(), vz = translation.Z();
+  const float range_min = scan.range_min();
+  const float range_max = scan.range_max();
+  const float time_step = sweep / count;
+  const bool has_intensities =
+    static_cast<unsigned int>(scan.intensities_size()) >= count * vertical_count;
+  const float nan = std::numeric_limits<float>::quiet_NaN();
+  bool dense = true;
+
+  // one row per ring, ranges are stored ring by ring starting at the lowest
+  for (unsigned int j = 0; j < vertical_count; ++j)
+  {
+    uint8_t *row = &cloud->data[j * cloud->row_step];
+    const float cos_pitch = this->ray_tables_.cosPitch(j);
+    const float sin_pitch = this->ray_tables_.sinPitch(j);
+    for (unsigned int i = 0; i < count; ++i)
+    {
+      const unsigned int index = j * count + i;
+      const float r = scan.ranges(index);
+      const float intensity = has_intensities ? scan.intensities(index) : 0.0f;
+
+      const float px = r * cos_pitch * this->ray_tables_.cosYaw(i);
+      const float py = r * cos_pitch * this->ray_tables_.sinYaw(i);
+      const float pz = r * sin_pitch;
+
+      // Rodrigues rotation by share * angle, then the shifted translation
+      const float c = this->rolling_cos_[i];
+      const float sn = this->rolling_sin_[i];
+      const float s = this->rolling_share_[i];
+      const float dot = (ux * px + uy * py + uz * pz) * (1.0f - c);
+
+      // every ray is transformed, rays without a return are then replaced
+      // by NaN to keep the cloud organized
+      const bool valid = r >= range_min && r <= range_max;
+      dense &= valid;
+      const float x = valid ?
+        px * c + (uy * pz - uz * py) * sn + ux * dot + s * vx : nan;
+      const float y = valid ?
+        py * c + (uz * px - ux * pz) * sn + uy * dot + s * vy : nan;
+      const float z = valid ?
+        pz * c + (ux * py - uy * px) * sn + uz * dot + s * vz : nan;
+
+      this->rolling_layout_.write(row + i * cloud->point_step,
+        x, y, z, intensity, j, i * time_step);
+    }
+  }
+  cloud->is_dense = dense;
+
+  this->rolling_pub_queue_->push(cloud, this->rolling_pub_);
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_END();
+#endif
+}
 }
@@ -0,0 +1,320 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/*
+ * Desc: Model contacts plugin, publishes the contacts of all links of a
+ *       model from a single plugin instance.
+ */
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <gazebo/physics/World.hh>
+#include <gazebo/physics/PhysicsEngine.hh>
+#include <gazebo/physics/ContactManager.hh>
+#include <gazebo/transport/Node.hh>
+#include <sdf/sdf.hh>
+
+#ifdef ENABLE_PROFILER
+#include <ignition/common/Profiler.hh>
+#endif
+
+#include <tf/tf.h>
+
+#include <gazebo_plugins/gazebo_ros_model_contacts.h>
+#include <gazebo_plugins/gazebo_ros_bumper.h>
+
+namespace gazebo
+{
+// Register this plugin with the simulator
+GZ_REGISTER_MODEL_PLUGIN(GazeboRosModelContacts)
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+GazeboRosModelContacts::GazeboRosModelContacts()
+  : connect_count_(0), rosnode_(NULL), aggregated_(false), update_period_(0)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+GazeboRosModelContacts::~GazeboRosModelContacts()
+{
+  this->contacts_sub_.reset();
+
+  if (this->world_ && !this->filter_name_.empty())
+  {
+#if GAZEBO_MAJOR_VERSION >= 8
+    this->world_->Physics()->GetContactManager()->RemoveFilter(
+      this->filter_name_);
+#else
+    this->world_->GetPhysicsEngine()->GetContactManager()->RemoveFilter(
+      this->filter_name_);
+#endif
+  }
+
+  if (this->rosnode_)
+  {
+    this->rosnode_->shutdown();
+    delete this->rosnode_;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Load the controller
+void GazeboRosModelContacts::Load(physics::ModelPtr _parent,
+                                  sdf::ElementPtr _sdf)
+{
+  this->model_ = _parent;
+  this->world_ = _parent->GetWorld();
+
+  this->robot_namespace_ = "";
+  if (_sdf->HasElement("robotNamespace"))
+    this->robot_namespace_ = _sdf->Get<std::string>("robotNamespace") + "/";
+
+  if (!_sdf->HasElement("topicName"))
+  {
+    ROS_INFO_NAMED("model_contacts", "Model contacts plugin missing <topicName>, defaults to contacts");
+    this->topic_name_ = "contacts";
+  }
+  else
+    this->topic_name_ = _sdf->Get<std::string>("topicName");
+
+  if (!_sdf->HasElement("frameName"))
+  {
+    ROS_INFO_NAMED("model_contacts", "Model contacts plugin missing <frameName>, defaults to world");
+    this->frame_name_ = "world";
+  }
+  else
+    this->frame_name_ = _sdf->Get<std::string>("frameName");
+
+  if (_sdf->HasElement("outputMode"))
+  {
+    std::string output_mode = _sdf->Get<std::string>("outputMode");
+    if (output_mode == "aggregated")
+      this->aggregated_ = true;
+    else if (output_mode != "raw")
+      ROS_WARN_NAMED("model_contacts", "Model contacts plugin <outputMode> %s is not "
+        "raw or aggregated, defaults to raw", output_mode.c_str());
+  }
+
+  double update_rate = 0;
+  if (!_sdf->HasElement("updateRate"))
+    ROS_INFO_NAMED("model_contacts", "Model contacts plugin missing <updateRate>, defaults to 0");
+  else
+    update_rate = _sdf->Get<double>("updateRate");
+  this->update_period_ = update_rate > 0.0 ? 1.0/update_rate : 0.0;
+
+  std::vector<std::string> link_names;
+  if (_sdf->HasElement("linkNames"))
+  {
+    std::istringstream names(_sdf->Get<std::string>("linkNames"));
+    std::string name;
+    while (names >> name)
+      link_names.push_back(name);
+  }
+
+  // Make sure the ROS node for Gazebo has already been initialized
+  if (!ros::isInitialized())
+  {
+    ROS_FATAL_STREAM_NAMED("model_contacts", "A ROS node for Gazebo has not been initialized, unable to load plugin. "
+      << "Load the Gazebo system plugin 'libgazebo_ros_api_plugin.so' in the gazebo_ros package)");
+    return;
+  }
+
+  this->rosnode_ = new ros::NodeHandle(this->robot_namespace_);
+
+  std::string prefix;
+  this->rosnode_->getParam(std::string("tf_prefix"), prefix);
+  this->frame_name_ = tf::resolve(prefix, this->frame_name_);
+
+  // one bucket per link, indexed by the scoped names of its collisions
+  std::vector<std::string> collisions;
+  const physics::Link_V &links = this->model_->GetLinks();
+  for (physics::Link_V::const_iterator link = links.begin();
+       link != links.end(); ++link)
+  {
+    if (!link_names.empty() &&
+        std::find(link_names.begin(), link_names.end(), (*link)->GetName()) ==
+        link_names.end())
+      continue;
+
+    const unsigned int bucket = this->link_names_.size();
+    const physics::Collision_V &link_collisions = (*link)->GetCollisions();
+    for (physics::Collision_V::const_iterator collision = link_collisions.begin();
+         collision != link_collisions.end(); ++collision)
+    {
+      collisions.push_back((*collision)->GetScopedName());
+      this->collision_links_[collisions.back()] = bucket;
+    }
+    this->link_names_.push_back((*link)->GetName());
+  }
+
+  for (size_t i = 0; i < link_names.size(); ++i)
+  {
+    if (std::find(this->link_names_.begin(), this->link_names_.end(),
+                  link_names[i]) == this->link_names_.end())
+      ROS_WARN_NAMED("model_contacts", "Model contacts plugin: link [%s] not found in model [%s]",
+        link_names[i].c_str(), this->model_->GetName().c_str());
+  }
+
+  if (collisions.empty())
+  {
+    ROS_ERROR_NAMED("model_contacts", "Model contacts plugin: model [%s] has no collisions to report",
+      this->model_->GetName().c_str());
+    return;
+  }
+  this->buckets_.resize(this->link_names_.size());
+
+  // a single filter for all collisions, the contact manager publishes
+  // the contacts of the filter once per physics step
+  this->filter_name_ = this->model_->GetScopedName() + "::" + this->GetHandle();
+#if GAZEBO_MAJOR_VERSION >= 8
+  this->contacts_topic_ = this->world_->Physics()->GetContactManager()->
+    CreateFilter(this->filter_name_, collisions);
+#else
+  this->contacts_topic_ = this->world_->GetPhysicsEngine()->GetContactManager()->
+    CreateFilter(this->filter_name_, collisions);
+#endif
+
+  this->gazebo_node_ = transport::NodePtr(new transport::Node());
+#if GAZEBO_MAJOR_VERSION >= 8
+  this->gazebo_node_->Init(this->world_->Name());
+#else
+  this->gazebo_node_->Init(this->world_->GetName());
+#endif
+
+  // publish multi queue
+  this->pmq.startServiceThread();
+  this->pub_queue_ = this->pmq.addPub<gazebo_msgs::ModelContacts>();
+
+  // contacts are only kept by the contact manager while subscribed
+  ros::AdvertiseOptions ao =
+    ros::AdvertiseOptions::create<gazebo_msgs::ModelContacts>(
+    this->topic_name_, 1,
+    boost::bind(&GazeboRosModelContacts::ContactsConnect, this),
+    boost::bind(&GazeboRosModelContacts::ContactsDisconnect, this),
+    ros::VoidPtr(), NULL);
+  this->pub_ = this->rosnode_->advertise(ao);
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  this->last_update_time_ = this->world_->SimTime();
+#else
+  this->last_update_time_ = this->world_->GetSimTime();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Increment count
+void GazeboRosModelContacts::ContactsConnect()
+{
+  this->connect_count_++;
+  if (this->connect_count_ == 1)
+    this->contacts_sub_ = this->gazebo_node_->Subscribe(this->contacts_topic_,
+      &GazeboRosModelContacts::OnContacts, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Decrement count
+void GazeboRosModelContacts::ContactsDisconnect()
+{
+  this->connect_count_--;
+  if (this->connect_count_ == 0)
+    this->contacts_sub_.reset();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Group the contacts by link and publish them
+void GazeboRosModelContacts::OnContacts(ConstContactsPtr &_msg)
+{
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE("GazeboRosModelContacts::OnContacts");
+#endif
+  if (this->pub_.getNumSubscribers() == 0)
+    return;
+
+  common::Time stamp = msgs::Convert(_msg->time());
+  if (this->update_period_ > 0 &&
+      (stamp - this->last_update_time_).Double() < this->update_period_)
+    return;
+  this->last_update_time_ = stamp;
+
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_BEGIN("fill ROS message");
+#endif
+  // bucket the contacts by the link of collision1, or of collision2 for
+  // contacts with another model reported the other way round, which are
+  // then filled from the side of collision2
+  for (size_t l = 0; l < this->buckets_.size(); ++l)
+    this->buckets_[l].clear();
+
+  int contact_count = 0;
+  for (int i = 0; i < _msg->contact_size(); ++i)
+  {
+    const msgs::Contact &contact = _msg->contact(i);
+    std::unordered_map<std::string, unsigned int>::const_iterator it =
+      this->collision_links_.find(contact.collision1());
+    bool swapped = false;
+    if (it == this->collision_links_.end())
+    {
+      it = this->collision_links_.find(contact.collision2());
+      swapped = true;
+    }
+    if (it == this->collision_links_.end())
+      continue;
+    this->buckets_[it->second].push_back(std::make_pair(i, swapped));
+    ++contact_count;
+  }
+
+  MessagePool<gazebo_msgs::ModelContacts>::MessagePtr msg =
+    this->msg_pool_.acquire(contact_count * sizeof(gazebo_msgs::ContactState));
+  msg->header.frame_id = this->frame_name_;
+  msg->header.stamp = ros::Time(stamp.sec, stamp.nsec);
+  msg->link_names.clear();
+  msg->link_state_counts.clear();
+  msg->states.resize(contact_count);
+
+  // contacts are reported in world frame, like gazebo_ros_bumper
+  const ignition::math::Pose3d frame_pose;
+  int k = 0;
+  for (size_t l = 0; l < this->buckets_.size(); ++l)
+  {
+    const std::vector<std::pair<int, bool> > &bucket = this->buckets_[l];
+    if (bucket.empty())
+      continue;
+
+    msg->link_names.push_back(this->link_names_[l]);
+    msg->link_state_counts.push_back(bucket.size());
+    for (size_t i = 0; i < bucket.size(); ++i, ++k)
+    {
+      const msgs::Contact &contact = _msg->contact(bucket[i].first);
+      if (this->aggregated_)
+        GazeboRosBumper::AggregateContactState(contact, frame_pose,
+                                               msg->states[k], bucket[i].second);
+      else
+        GazeboRosBumper::FillContactState(contact, frame_pose,
+                                          msg->states[k], bucket[i].second);
+    }
+  }
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE_END();
+#endif
+
+  this->pub_queue_->push(msg, this->pub_);
+}
+}
@@ -20,8 +20,11 @@
  * Date: 10 June 2013
  */
 
+#include <algorithm>
 #include <string>
 
+#include <sensor_msgs/fill_image.h>
+
 #include <gazebo/sensors/Sensor.hh>
 #include <gazebo/sensors/MultiCameraSensor.hh>
 #include <gazebo/sensors/SensorTypes.hh>
@@ -41,12 +44,16 @@ GZ_REGISTER_SENSOR_PLUGIN(GazeboRosMultiCamera)
 // Constructor
 GazeboRosMultiCamera::GazeboRosMultiCamera()
 {
+  this->bundle_connect_count_ = 0;
+  this->bundle_pending_ = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 // Destructor
 GazeboRosMultiCamera::~GazeboRosMultiCamera()
 {
+  this->bundle_pub_.shutdown();
+  this->bundle_rosnode_.reset();
 }
 
 void GazeboRosMultiCamera::Load(sensors::SensorPtr _parent,
@@ -95,6 +102,99 @@ void GazeboRosMultiCamera::Load(sensors::SensorPtr _parent,
     }
     this->utils.push_back(util);
   }
+
+  // optional output bundling the images of all cameras in one message
+  if (_sdf->HasElement("bundleTopicName"))
+  {
+    std::string camera_name;
+    if (_sdf->HasElement("cameraName"))
+      camera_name = _sdf->Get<std::string>("cameraName");
+
+    this->bundle_msg_.images.resize(this->utils.size());
+    this->bundle_msg_.camera_infos.resize(this->utils.size());
+    this->bundle_received_.assign(this->utils.size(), false);
+    this->bundle_pending_ = this->utils.size();
+
+    this->bundle_rosnode_.reset(new ros::NodeHandle(
+      GetRobotNamespace(_parent, _sdf) + "/" + camera_name));
+
+    ros::AdvertiseOptions ao =
+      ros::AdvertiseOptions::create<gazebo_msgs::MultiCameraFrame>(
+      _sdf->Get<std::string>("bundleTopicName"), 2,
+      boost::bind(&GazeboRosMultiCamera::BundleConnect, this),
+      boost::bind(&GazeboRosMultiCamera::BundleDisconnect, this),
+      ros::VoidPtr(), NULL);
+    this->bundle_pub_ = this->bundle_rosnode_->advertise(ao);
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Increment count
+void GazeboRosMultiCamera::BundleConnect()
+{
+  {
+    boost::mutex::scoped_lock lock(this->bundle_lock_);
+    this->bundle_connect_count_++;
+  }
+  // activate the sensor through the counter shared with the camera topics
+  this->utils[0]->ImageConnect();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Decrement count
+void GazeboRosMultiCamera::BundleDisconnect()
+{
+  {
+    boost::mutex::scoped_lock lock(this->bundle_lock_);
+    this->bundle_connect_count_--;
+  }
+  this->utils[0]->ImageDisconnect();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Add a frame to the bundle, publish when all cameras have delivered
+void GazeboRosMultiCamera::BundleFrame(const unsigned char *_image,
+    unsigned int _index, const common::Time &_stamp)
+{
+  GazeboRosCameraUtils *util = this->utils[_index];
+  if (!util->initialized_ || util->height_ <= 0 || util->width_ <= 0)
+    return;
+
+  boost::mutex::scoped_lock lock(this->bundle_lock_);
+
+  // a new measurement time starts a new bundle, frames left over from an
+  // incomplete bundle are dropped
+  if (_stamp != this->bundle_stamp_)
+  {
+    std::fill(this->bundle_received_.begin(), this->bundle_received_.end(),
+        false);
+    this->bundle_pending_ = this->utils.size();
+    this->bundle_stamp_ = _stamp;
+  }
+
+  if (this->bundle_received_[_index])
+    return;
+
+  sensor_msgs::Image &image = this->bundle_msg_.images[_index];
+  image.header.frame_id = util->frame_name_;
+  image.header.stamp.sec = _stamp.sec;
+  image.header.stamp.nsec = _stamp.nsec;
+
+  // fillImage resizes in place, so the buffer is only allocated once
+  fillImage(image, util->type_, util->height_, util->width_,
+      util->skip_*util->width_, reinterpret_cast<const void*>(_image));
+
+  sensor_msgs::CameraInfo &info = this->bundle_msg_.camera_infos[_index];
+  info = util->camera_info_manager_->getCameraInfo();
+  info.header.stamp = image.header.stamp;
+
+  this->bundle_received_[_index] = true;
+  if (--this->bundle_pending_ == 0)
+  {
+    this->bundle_msg_.header.frame_id = this->bundle_msg_.images[0].header.frame_id;
+    this->bundle_msg_.header.stamp = image.header.stamp;
+    this->bundle_pub_.publish(this->bundle_msg_);
+  }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -115,10 +215,18 @@ void GazeboRosMultiCamera::OnNewFrame(const unsigned char *_image,
   {
     if (sensor_update_time - util->last_update_time_ >= util->update_period_)
     {
+      // when only the bundle is subscribed, skip filling the per-camera
+      // images nobody listens to
+      bool bundled;
+      {
+        boost::mutex::scoped_lock lock(this->bundle_lock_);
+        bundled = this->bundle_connect_count_ > 0;
+      }
 #ifdef ENABLE_PROFILER
       IGN_PROFILE_BEGIN("PutCameraData");
 #endif
-      util->PutCameraData(_image, sensor_update_time);
+      if (!bundled || util->image_pub_.getNumSubscribers() > 0)
+        util->PutCameraData(_image, sensor_update_time);
 #ifdef ENABLE_PROFILER
       IGN_PROFILE_END();
       IGN_PROFILE_BEGIN("PublishCameraInfo");
@@ -127,6 +235,19 @@ void GazeboRosMultiCamera::OnNewFrame(const unsigned char *_image,
 #ifdef ENABLE_PROFILER
       IGN_PROFILE_END();
 #endif
+      if (bundled)
+      {
+#ifdef ENABLE_PROFILER
+        IGN_PROFILE_BEGIN("BundleFrame");
+#endif
+        unsigned int index =
+          std::find(this->utils.begin(), this->utils.end(), util) -
+          this->utils.begin();
+        this->BundleFrame(_image, index, sensor_update_time);
+#ifdef ENABLE_PROFILER
+        IGN_PROFILE_END();
+#endif
+      }
       util->last_update_time_ = sensor_update_time;
     }
   }
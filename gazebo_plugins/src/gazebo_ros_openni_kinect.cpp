@@ -278,21 +278,24 @@ void GazeboRosOpenniKinect::FillPointdCloud(const float *_src)
 {
   this->lock_.lock();
 
-  this->point_cloud_msg_.header.frame_id = this->frame_name_;
-  this->point_cloud_msg_.header.stamp.sec = this->depth_sensor_update_time_.sec;
-  this->point_cloud_msg_.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
-  this->point_cloud_msg_.width = this->width;
-  this->point_cloud_msg_.height = this->height;
-  this->point_cloud_msg_.row_step = this->point_cloud_msg_.point_step * this->width;
+  sensor_msgs::PointCloud2Ptr point_cloud_msg =
+    this->point_cloud_pool_.acquire(this->width * this->height * 32);
+
+  point_cloud_msg->header.frame_id = this->frame_name_;
+  point_cloud_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  point_cloud_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+  point_cloud_msg->width = this->width;
+  point_cloud_msg->height = this->height;
+  point_cloud_msg->row_step = point_cloud_msg->point_step * this->width;
 
   ///copy from depth to point cloud message
-  FillPointCloudHelper(this->point_cloud_msg_,
+  FillPointCloudHelper(*point_cloud_msg,
                  this->height,
                  this->width,
                  this->skip_,
                  (void*)_src );
 
-  this->point_cloud_pub_.publish(this->point_cloud_msg_);
+  this->point_cloud_pub_.publish(point_cloud_msg);
 
   this->lock_.unlock();
 }
@@ -302,19 +305,23 @@ void GazeboRosOpenniKinect::FillPointdCloud(const float *_src)
 void GazeboRosOpenniKinect::FillDepthImage(const float *_src)
 {
   this->lock_.lock();
+
+  sensor_msgs::ImagePtr depth_image_msg =
+    this->depth_image_pool_.acquire(this->width * this->height * sizeof(float));
+
   // copy data into image
-  this->depth_image_msg_.header.frame_id = this->frame_name_;
-  this->depth_image_msg_.header.stamp.sec = this->depth_sensor_update_time_.sec;
-  this->depth_image_msg_.header.stamp.nsec = this->depth_sensor_update_time_.nsec;
+  depth_image_msg->header.frame_id = this->frame_name_;
+  depth_image_msg->header.stamp.sec = this->depth_sensor_update_time_.sec;
+  depth_image_msg->header.stamp.nsec = this->depth_sensor_update_time_.nsec;
 
   ///copy from depth to depth image message
-  FillDepthImageHelper(this->depth_image_msg_,
+  FillDepthImageHelper(*depth_image_msg,
                  this->height,
                  this->width,
                  this->skip_,
                  (void*)_src );
 
-  this->depth_image_pub_.publish(this->depth_image_msg_);
+  this->depth_image_pub_.publish(depth_image_msg);
 
   this->lock_.unlock();
 }
@@ -332,10 +339,10 @@ bool GazeboRosOpenniKinect::FillPointCloudHelper(
   pcd_modifier.resize(rows_arg*cols_arg);
   point_cloud_msg.is_dense = true;
 
-  sensor_msgs::PointCloud2Iterator<float> iter_x(point_cloud_msg_, "x");
-  sensor_msgs::PointCloud2Iterator<float> iter_y(point_cloud_msg_, "y");
-  sensor_msgs::PointCloud2Iterator<float> iter_z(point_cloud_msg_, "z");
-  sensor_msgs::PointCloud2Iterator<uint8_t> iter_rgb(point_cloud_msg_, "rgb");
+  sensor_msgs::PointCloud2Iterator<float> iter_x(point_cloud_msg, "x");
+  sensor_msgs::PointCloud2Iterator<float> iter_y(point_cloud_msg, "y");
+  sensor_msgs::PointCloud2Iterator<float> iter_z(point_cloud_msg, "z");
+  sensor_msgs::PointCloud2Iterator<uint8_t> iter_rgb(point_cloud_msg, "rgb");
 
   float* toCopyFrom = (float*)data_arg;
   int index = 0;
@@ -376,15 +383,16 @@ bool GazeboRosOpenniKinect::FillPointCloudHelper(
       }
 
       // put image color data for each point
-      uint8_t*  image_src = (uint8_t*)(&(this->image_msg_.data[0]));
-      if (this->image_msg_.data.size() == rows_arg*cols_arg*3)
+      const size_t image_size = this->last_image_ ? this->last_image_->data.size() : 0;
+      const uint8_t* image_src = image_size ? &this->last_image_->data[0] : NULL;
+      if (image_size == rows_arg*cols_arg*3)
       {
         // color
         iter_rgb[0] = image_src[i*3+j*cols_arg*3+0];
         iter_rgb[1] = image_src[i*3+j*cols_arg*3+1];
         iter_rgb[2] = image_src[i*3+j*cols_arg*3+2];
       }
-      else if (this->image_msg_.data.size() == rows_arg*cols_arg)
+      else if (image_size == rows_arg*cols_arg)
       {
         // mono (or bayer?  @todo; fix for bayer)
         iter_rgb[0] = image_src[i+j*cols_arg];
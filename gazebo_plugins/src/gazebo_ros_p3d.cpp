@@ -20,6 +20,7 @@
 #include <stdlib.h>
 
 #include "gazebo_plugins/gazebo_ros_p3d.h"
+#include <gazebo_plugins/gazebo_ros_utils.h>
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
 #endif
@@ -78,6 +79,9 @@ void GazeboRosP3D::Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf)
     return;
   }
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(this->noise_, _sdf, this->link_->GetScopedName(), "P3D");
+
   if (!_sdf->HasElement("topicName"))
   {
     ROS_FATAL_NAMED("p3d", "p3d plugin missing <topicName>, cannot proceed");
@@ -325,18 +329,18 @@ void GazeboRosP3D::UpdateChild()
         this->pose_msg_.pose.pose.orientation.w = pose.Rot().W();
 
         this->pose_msg_.twist.twist.linear.x  = vpos.X() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
         this->pose_msg_.twist.twist.linear.y  = vpos.Y() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
         this->pose_msg_.twist.twist.linear.z  = vpos.Z() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
         // pass euler angular rates
         this->pose_msg_.twist.twist.angular.x = veul.X() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
         this->pose_msg_.twist.twist.angular.y = veul.Y() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
         this->pose_msg_.twist.twist.angular.z = veul.Z() +
-          this->GaussianKernel(0, this->gaussian_noise_);
+          this->noise_.gaussian(0, this->gaussian_noise_);
 
         // fill in covariance matrix
         /// @todo: let user set separate linear and angular covariance values.
@@ -370,28 +374,6 @@ void GazeboRosP3D::UpdateChild()
 #endif
 }
 
-//////////////////////////////////////////////////////////////////////////////
-// Utility for adding noise
-double GazeboRosP3D::GaussianKernel(double mu, double sigma)
-{
-  // using Box-Muller transform to generate two independent standard
-  // normally disbributed normal variables see wikipedia
-
-  // normalized uniform random variable
-  double U = ignition::math::Rand::DblUniform();
-
-  // normalized uniform random variable
-  double V = ignition::math::Rand::DblUniform();
-
-  double X = sqrt(-2.0 * ::log(U)) * cos(2.0*M_PI * V);
-  // double Y = sqrt(-2.0 * ::log(U)) * sin(2.0*M_PI * V);
-
-  // there are 2 indep. vars, we'll just use X
-  // scale to our mu and sigma
-  X = sigma * X + mu;
-  return X;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 // Put laser data to the interface
 void GazeboRosP3D::P3DQueueThread()
@@ -284,19 +284,21 @@ void GazeboRosProsilica::pollCallback(polled_camera::GetPolledImage::Request& re
         this->roiCameraInfoMsg->P[11] = 0.0;
         this->camera_info_pub_.publish(*this->roiCameraInfoMsg);
 
-        // copy data into image_msg_, then convert to roiImageMsg(image)
-        this->image_msg_.header.frame_id    = this->frame_name_;
+        // copy data into a pooled image, then convert to roiImageMsg(image)
+        sensor_msgs::ImagePtr image_msg =
+          this->image_pool_.acquire(this->skip_*this->width_*this->height_);
+        image_msg->header.frame_id    = this->frame_name_;
 
         common::Time lastRenderTime = this->parentSensor_->LastMeasurementTime();
-        this->image_msg_.header.stamp.sec = lastRenderTime.sec;
-        this->image_msg_.header.stamp.nsec = lastRenderTime.nsec;
+        image_msg->header.stamp.sec = lastRenderTime.sec;
+        image_msg->header.stamp.nsec = lastRenderTime.nsec;
 
         //unsigned char dst[this->width_*this->height];
 
         /// @todo: don't bother if there are no subscribers
 
-        // copy from src to image_msg_
-        fillImage(this->image_msg_,
+        // copy from src to image_msg
+        fillImage(*image_msg,
                   this->type_,
                   this->height_,
                   this->width_,
@@ -305,7 +307,8 @@ void GazeboRosProsilica::pollCallback(polled_camera::GetPolledImage::Request& re
 
         /// @todo: publish to ros, thumbnails and rect image in the Update call?
 
-        this->image_pub_.publish(this->image_msg_);
+        // intra-process subscribers get the pooled message itself
+        this->image_pub_.publish(image_msg);
 
         {
           // copy data into ROI image
@@ -315,9 +318,9 @@ void GazeboRosProsilica::pollCallback(polled_camera::GetPolledImage::Request& re
           this->roiImageMsg->header.stamp.sec = roiLastRenderTime.sec;
           this->roiImageMsg->header.stamp.nsec = roiLastRenderTime.nsec;
 
-          // convert image_msg_ to a CvImage using cv_bridge
-          boost::shared_ptr<cv_bridge::CvImage> img_bridge_;
-          img_bridge_ = cv_bridge::toCvCopy(this->image_msg_);
+          // view image_msg as a cv::Mat using cv_bridge, the published
+          // message is shared and left untouched
+          cv_bridge::CvImageConstPtr img_bridge_ = cv_bridge::toCvShare(image_msg);
 
           // for debug
           //cvNamedWindow("showme",CV_WINDOW_AUTOSIZE);
@@ -329,10 +332,10 @@ void GazeboRosProsilica::pollCallback(polled_camera::GetPolledImage::Request& re
           cv::Mat roi(img_bridge_->image,
             cv::Rect(req.roi.x_offset, req.roi.y_offset,
                      req.roi.width, req.roi.height));
-          img_bridge_->image = roi;
 
           // copy roi'd image into roiImageMsg
-          img_bridge_->toImageMsg(*this->roiImageMsg);
+          cv_bridge::CvImage(img_bridge_->header, img_bridge_->encoding, roi)
+            .toImageMsg(*this->roiImageMsg);
         }
       }
     }
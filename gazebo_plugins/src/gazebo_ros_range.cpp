@@ -148,6 +148,9 @@ void GazeboRosRange::Load(sensors::SensorPtr _parent, sdf::ElementPtr _sdf)
   else
     this->gaussian_noise_ = this->sdf->Get<double>("gaussianNoise");
 
+  // noise stream of this plugin, replayable with <noiseSeed>
+  SeedNoiseStream(this->noise_, this->sdf, this->parent_sensor_->ScopedName(), "Range");
+
   if (!this->sdf->HasElement("updateRate"))
   {
     ROS_INFO_NAMED("range", "Range plugin missing <updateRate>, defaults to 0");
@@ -313,7 +316,7 @@ void GazeboRosRange::PutRangeData(common::Time &_updateTime)
 
     // add Gaussian noise and limit to min/max range
     if (range_msg_.range < range_msg_.max_range)
-        range_msg_.range = std::min(range_msg_.range + this->GaussianKernel(0,gaussian_noise_), parent_ray_sensor_->RangeMax());
+        range_msg_.range = std::min(range_msg_.range + this->noise_.gaussian(0,gaussian_noise_), parent_ray_sensor_->RangeMax());
 
     this->parent_ray_sensor_->SetActive(true);
 
@@ -323,28 +326,6 @@ void GazeboRosRange::PutRangeData(common::Time &_updateTime)
   }
 }
 
-//////////////////////////////////////////////////////////////////////////////
-// Utility for adding noise
-double GazeboRosRange::GaussianKernel(double mu, double sigma)
-{
-  // using Box-Muller transform to generate two independent standard
-  // normally disbributed normal variables see wikipedia
-
-  // normalized uniform random variable
-  double U = ignition::math::Rand::DblUniform();
-
-  // normalized uniform random variable
-  double V = ignition::math::Rand::DblUniform();
-
-  double X = sqrt(-2.0 * ::log(U)) * cos(2.0*M_PI * V);
-  // double Y = sqrt(-2.0 * ::log(U)) * sin(2.0*M_PI * V);
-
-  // there are 2 indep. vars, we'll just use X
-  // scale to our mu and sigma
-  X = sigma * X + mu;
-  return X;
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 // Put range data to the interface
 void GazeboRosRange::RangeQueueThread()
@@ -0,0 +1,403 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+/*
+ * Desc: Range array plugin, publishes all ray sensors of a sonar ring
+ *       from a single plugin instance.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include <gazebo/physics/World.hh>
+#include <gazebo/sensors/Sensor.hh>
+#include <gazebo/sensors/SensorManager.hh>
+#include <gazebo/sensors/RaySensor.hh>
+#include <sdf/sdf.hh>
+
+#ifdef ENABLE_PROFILER
+#include <ignition/common/Profiler.hh>
+#endif
+
+#include <tf/tf.h>
+
+#include <gazebo_plugins/gazebo_ros_range_array.h>
+#include <gazebo_plugins/gazebo_ros_utils.h>
+
+namespace gazebo
+{
+// Register this plugin with the simulator
+GZ_REGISTER_MODEL_PLUGIN(GazeboRosRangeArray)
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+GazeboRosRangeArray::GazeboRosRangeArray()
+  : sensors_found_(false), rosnode_(NULL), output_individual_(false),
+    sensors_active_(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Destructor
+GazeboRosRangeArray::~GazeboRosRangeArray()
+{
+  this->update_connection_.reset();
+
+  if (this->rosnode_)
+  {
+    this->rosnode_->shutdown();
+    delete this->rosnode_;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Load the controller
+void GazeboRosRangeArray::Load(physics::ModelPtr _parent, sdf::ElementPtr _sdf)
+{
+  this->model_ = _parent;
+  this->world_ = _parent->GetWorld();
+  this->sdf = _sdf;
+
+  this->robot_namespace_ = "";
+  if (this->sdf->HasElement("robotNamespace"))
+    this->robot_namespace_ = this->sdf->Get<std::string>("robotNamespace") + "/";
+
+  if (!this->sdf->HasElement("topicName"))
+  {
+    ROS_INFO_NAMED("range_array", "Range array plugin missing <topicName>, defaults to range_array");
+    this->topic_name_ = "range_array";
+  }
+  else
+    this->topic_name_ = this->sdf->Get<std::string>("topicName");
+
+  if (this->sdf->HasElement("outputType"))
+  {
+    std::string output_type = this->sdf->Get<std::string>("outputType");
+    if (output_type == "Range")
+      this->output_individual_ = true;
+    else if (output_type != "RangeArray")
+      ROS_WARN_NAMED("range_array", "Range array plugin <outputType> [%s] invalid, "
+        "use Range or RangeArray. Defaults to RangeArray", output_type.c_str());
+  }
+
+  if (!this->sdf->HasElement("radiation"))
+  {
+    ROS_WARN_NAMED("range_array", "Range array plugin missing <radiation>, defaults to ultrasound");
+    this->radiation_ = "ultrasound";
+  }
+  else
+    this->radiation_ = this->sdf->Get<std::string>("radiation");
+
+  if (!this->sdf->HasElement("fov"))
+  {
+    ROS_WARN_NAMED("range_array", "Range array plugin missing <fov>, defaults to 0.05");
+    this->fov_ = 0.05;
+  }
+  else
+    this->fov_ = this->sdf->Get<double>("fov");
+
+  if (!this->sdf->HasElement("gaussianNoise"))
+  {
+    ROS_INFO_NAMED("range_array", "Range array plugin missing <gaussianNoise>, defaults to 0.0");
+    this->gaussian_noise_ = 0;
+  }
+  else
+    this->gaussian_noise_ = this->sdf->Get<double>("gaussianNoise");
+
+  double update_rate = 0;
+  if (!this->sdf->HasElement("updateRate"))
+    ROS_INFO_NAMED("range_array", "Range array plugin missing <updateRate>, defaults to 0");
+  else
+    update_rate = this->sdf->Get<double>("updateRate");
+  this->update_period_ = update_rate > 0.0 ? 1.0/update_rate : 0.0;
+
+  if (this->sdf->HasElement("sensorNames"))
+  {
+    std::istringstream names(this->sdf->Get<std::string>("sensorNames"));
+    std::string name;
+    while (names >> name)
+      this->sensor_names_.push_back(name);
+  }
+
+  // Make sure the ROS node for Gazebo has already been initialized
+  if (!ros::isInitialized())
+  {
+    ROS_FATAL_STREAM_NAMED("range_array", "A ROS node for Gazebo has not been initialized, unable to load plugin. "
+      << "Load the Gazebo system plugin 'libgazebo_ros_api_plugin.so' in the gazebo_ros package)");
+    return;
+  }
+
+  this->rosnode_ = new ros::NodeHandle(this->robot_namespace_);
+
+  std::string prefix;
+  this->rosnode_->getParam(std::string("tf_prefix"), prefix);
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  const std::string world_name = this->world_->Name();
+#else
+  const std::string world_name = this->world_->GetName();
+#endif
+
+  // collect the ray sensors of all links, the sensors themselves are
+  // created by the sensor manager after the model plugins are loaded
+  std::vector<std::string> names;
+  sensor_msgs::Range range_msg;
+  range_msg.radiation_type = this->radiation_ == "ultrasound" ?
+    sensor_msgs::Range::ULTRASOUND : sensor_msgs::Range::INFRARED;
+  range_msg.field_of_view = this->fov_;
+
+  const physics::Link_V &links = this->model_->GetLinks();
+  for (physics::Link_V::const_iterator link = links.begin();
+       link != links.end(); ++link)
+  {
+    sdf::ElementPtr sensor_sdf;
+    if ((*link)->GetSDF()->HasElement("sensor"))
+      sensor_sdf = (*link)->GetSDF()->GetElement("sensor");
+    for (; sensor_sdf; sensor_sdf = sensor_sdf->GetNextElement("sensor"))
+    {
+      if (sensor_sdf->Get<std::string>("type") != "ray")
+        continue;
+
+      const std::string name = sensor_sdf->Get<std::string>("name");
+      if (!this->sensor_names_.empty() &&
+          std::find(this->sensor_names_.begin(), this->sensor_names_.end(),
+                    name) == this->sensor_names_.end())
+        continue;
+
+      RangeSensor sensor;
+      sensor.measured = false;
+      sensor.scoped_name = world_name + "::" + (*link)->GetScopedName() +
+                           "::" + name;
+      SeedNoiseStream(sensor.noise, this->sdf, sensor.scoped_name);
+      this->sensors_.push_back(sensor);
+      names.push_back(name);
+
+      range_msg.header.frame_id = tf::resolve(prefix, (*link)->GetName());
+      this->array_msg_.ranges.push_back(range_msg);
+    }
+  }
+
+  // keep the order given in <sensorNames>
+  if (!this->sensor_names_.empty())
+  {
+    std::vector<RangeSensor> sensors;
+    std::vector<sensor_msgs::Range> ranges;
+    for (size_t i = 0; i < this->sensor_names_.size(); ++i)
+    {
+      size_t j = std::find(names.begin(), names.end(), this->sensor_names_[i]) -
+                 names.begin();
+      if (j == names.size())
+      {
+        ROS_WARN_NAMED("range_array", "Range array plugin: ray sensor [%s] not found in model [%s]",
+          this->sensor_names_[i].c_str(), this->model_->GetName().c_str());
+        continue;
+      }
+      sensors.push_back(this->sensors_[j]);
+      ranges.push_back(this->array_msg_.ranges[j]);
+    }
+    this->sensors_.swap(sensors);
+    this->array_msg_.ranges.swap(ranges);
+  }
+
+  if (this->sensors_.empty())
+  {
+    ROS_ERROR_NAMED("range_array", "Range array plugin: model [%s] has no ray sensors to publish",
+      this->model_->GetName().c_str());
+    return;
+  }
+
+  // publish multi queue
+  this->pmq.startServiceThread();
+
+  if (this->output_individual_)
+  {
+    this->range_pub_queue_ = this->pmq.addPub<sensor_msgs::Range>();
+    for (size_t i = 0; i < this->sensors_.size(); ++i)
+    {
+      std::string name = this->sensors_[i].scoped_name.substr(
+        this->sensors_[i].scoped_name.rfind("::") + 2);
+      this->sensors_[i].pub = this->rosnode_->advertise<sensor_msgs::Range>(
+        this->topic_name_ + "/" + name, 1);
+    }
+  }
+  else
+  {
+    this->array_pub_queue_ = this->pmq.addPub<gazebo_msgs::RangeArray>();
+    this->pub_ = this->rosnode_->advertise<gazebo_msgs::RangeArray>(
+      this->topic_name_, 1);
+  }
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  this->last_update_time_ = this->world_->SimTime();
+#else
+  this->last_update_time_ = this->world_->GetSimTime();
+#endif
+
+  // New Mechanism for Updating every World Cycle
+  // Listen to the update event. This event is broadcast every
+  // simulation iteration.
+  this->update_connection_ = event::Events::ConnectWorldUpdateBegin(
+      boost::bind(&GazeboRosRangeArray::UpdateChild, this));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Look up the ray sensors
+bool GazeboRosRangeArray::FindSensors()
+{
+  GAZEBO_SENSORS_USING_DYNAMIC_POINTER_CAST;
+  bool found = true;
+  for (size_t i = 0; i < this->sensors_.size(); ++i)
+  {
+    RangeSensor &sensor = this->sensors_[i];
+    if (sensor.sensor)
+      continue;
+
+    sensor.sensor = dynamic_pointer_cast<sensors::RaySensor>(
+      sensors::get_sensor(sensor.scoped_name));
+    if (!sensor.sensor)
+    {
+      found = false;
+      continue;
+    }
+
+    this->array_msg_.ranges[i].min_range = sensor.sensor->RangeMin();
+    this->array_msg_.ranges[i].max_range = sensor.sensor->RangeMax();
+
+    // sensor generation off until somebody subscribes
+    sensor.sensor->SetActive(false);
+  }
+  return found;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Update the plugin
+void GazeboRosRangeArray::UpdateChild()
+{
+#ifdef ENABLE_PROFILER
+  IGN_PROFILE("GazeboRosRangeArray::UpdateChild");
+#endif
+  if (!this->sensors_found_)
+  {
+    this->sensors_found_ = this->FindSensors();
+    if (!this->sensors_found_)
+      return;
+  }
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  common::Time cur_time = this->world_->SimTime();
+#else
+  common::Time cur_time = this->world_->GetSimTime();
+#endif
+  if (cur_time < this->last_update_time_)
+  {
+    ROS_WARN_NAMED("range_array", "Negative sensor update time difference detected.");
+    this->last_update_time_ = cur_time;
+  }
+
+  if (cur_time - this->last_update_time_ >= this->update_period_)
+  {
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_BEGIN("PutRangeData");
+#endif
+    this->PutRangeData();
+#ifdef ENABLE_PROFILER
+    IGN_PROFILE_END();
+#endif
+    this->last_update_time_ = cur_time;
+  }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Put range data to the interface
+void GazeboRosRangeArray::PutRangeData()
+{
+  // only let the sensors generate data while somebody listens
+  bool connected = this->pub_.getNumSubscribers() > 0;
+  for (size_t i = 0; i < this->sensors_.size() && !connected; ++i)
+    connected = this->sensors_[i].pub.getNumSubscribers() > 0;
+
+  // sensors may be shared with other plugins, so they are only switched on
+  // and off when the subscribers come and go. A sensor switched off by
+  // another plugin just has no new scans to publish.
+  if (connected != this->sensors_active_)
+  {
+    for (size_t i = 0; i < this->sensors_.size(); ++i)
+      this->sensors_[i].sensor->SetActive(connected);
+    this->sensors_active_ = connected;
+  }
+  if (!connected)
+    return;
+
+  // take the new scans only, the same scan is not published twice
+  bool new_scans = false;
+  bool all_measured = true;
+  for (size_t i = 0; i < this->sensors_.size(); ++i)
+  {
+    RangeSensor &sensor = this->sensors_[i];
+    sensor_msgs::Range &range_msg = this->array_msg_.ranges[i];
+
+    common::Time sensor_time = sensor.sensor->LastMeasurementTime();
+    if (sensor.measured && sensor_time <= sensor.last_measurement_time)
+      continue;
+
+    // a sensor that was just switched on has no rays yet
+    sensor.sensor->Ranges(this->ray_ranges_);
+    if (this->ray_ranges_.empty())
+    {
+      all_measured = all_measured && sensor.measured;
+      continue;
+    }
+    sensor.last_measurement_time = sensor_time;
+    sensor.measured = true;
+    new_scans = true;
+
+    range_msg.header.stamp.sec = sensor_time.sec;
+    range_msg.header.stamp.nsec = sensor_time.nsec;
+
+    // find ray with minimal range
+    range_msg.range = std::numeric_limits<sensor_msgs::Range::_range_type>::max();
+    for (size_t j = 0; j < this->ray_ranges_.size(); ++j)
+    {
+      if (this->ray_ranges_[j] < range_msg.range)
+        range_msg.range = this->ray_ranges_[j];
+    }
+
+    // add Gaussian noise and limit to min/max range
+    if (range_msg.range < range_msg.max_range)
+      range_msg.range = std::min<double>(range_msg.range +
+        sensor.noise.gaussian(0, this->gaussian_noise_), range_msg.max_range);
+
+    if (this->output_individual_ && sensor.pub.getNumSubscribers() > 0)
+      this->range_pub_queue_->push(range_msg, sensor.pub);
+  }
+
+  // the array is complete once every sensor produced a scan
+  if (this->output_individual_ || !new_scans || !all_measured)
+    return;
+
+#if GAZEBO_MAJOR_VERSION >= 8
+  common::Time cur_time = this->world_->SimTime();
+#else
+  common::Time cur_time = this->world_->GetSimTime();
+#endif
+  this->array_msg_.header.stamp.sec = cur_time.sec;
+  this->array_msg_.header.stamp.nsec = cur_time.nsec;
+  this->array_pub_queue_->push(this->array_msg_, this->pub_);
+}
+}
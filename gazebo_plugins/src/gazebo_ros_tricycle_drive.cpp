@@ -43,6 +43,7 @@
 #include <assert.h>
 
 #include <gazebo_plugins/gazebo_ros_tricycle_drive.h>
+#include <gazebo_ros/joint_state_cache.h>
 
 #ifdef ENABLE_PROFILER
 #include <ignition/common/Profiler.hh>
@@ -131,6 +132,24 @@ void GazeboRosTricycleDrive::Load ( physics::ModelPtr _parent, sdf::ElementPtr _
     if ( this->publishWheelJointState_ ) {
         joint_state_publisher_ = gazebo_ros_->node()->advertise<sensor_msgs::JointState> ( "joint_states", 1000 );
         ROS_INFO_NAMED("tricycle_drive", "%s: Advertise joint_states", gazebo_ros_->info() );
+
+        // the wheels are read once per update for all plugins of the model
+        std::vector<physics::JointPtr> joints;
+        joints.push_back ( joint_steering_ );
+        joints.push_back ( joint_wheel_actuated_ );
+        joints.push_back ( joint_wheel_encoder_left_ );
+        joints.push_back ( joint_wheel_encoder_right_ );
+
+        joint_state_cache_ = JointStateCache::Get ( parent );
+        joint_state_.name.resize ( joints.size() );
+        joint_state_.position.resize ( joints.size() );
+        joint_state_.velocity.resize ( joints.size() );
+        joint_state_.effort.resize ( joints.size() );
+        joint_state_indices_.resize ( joints.size() );
+        for ( std::size_t i = 0; i < joints.size(); i++ ) {
+            joint_state_.name[i] = joints[i]->GetName();
+            joint_state_indices_[i] = joint_state_cache_->Register ( joints[i] );
+        }
     }
 
     transform_broadcaster_ = boost::shared_ptr<tf::TransformBroadcaster> ( new tf::TransformBroadcaster() );
@@ -159,27 +178,15 @@ void GazeboRosTricycleDrive::Load ( physics::ModelPtr _parent, sdf::ElementPtr _
 
 void GazeboRosTricycleDrive::publishWheelJointState()
 {
-    std::vector<physics::JointPtr> joints;
-    joints.push_back ( joint_steering_ );
-    joints.push_back ( joint_wheel_actuated_ );
-    joints.push_back ( joint_wheel_encoder_left_ );
-    joints.push_back ( joint_wheel_encoder_right_ );
-
     ros::Time current_time = ros::Time::now();
     joint_state_.header.stamp = current_time;
-    joint_state_.name.resize ( joints.size() );
-    joint_state_.position.resize ( joints.size() );
-    joint_state_.velocity.resize ( joints.size() );
-    joint_state_.effort.resize ( joints.size() );
-    for ( std::size_t i = 0; i < joints.size(); i++ ) {
-        joint_state_.name[i] = joints[i]->GetName();
-#if GAZEBO_MAJOR_VERSION >= 8
-        joint_state_.position[i] = joints[i]->Position ( 0 );
-#else
-        joint_state_.position[i] = joints[i]->GetAngle ( 0 ).Radian();
-#endif
-        joint_state_.velocity[i] = joints[i]->GetVelocity ( 0 );
-        joint_state_.effort[i] = joints[i]->GetForce ( 0 );
+
+    joint_state_cache_->Update();
+    for ( std::size_t i = 0; i < joint_state_indices_.size(); i++ ) {
+        const unsigned int index = joint_state_indices_[i];
+        joint_state_.position[i] = joint_state_cache_->Position ( index );
+        joint_state_.velocity[i] = joint_state_cache_->Velocity ( index );
+        joint_state_.effort[i] = joint_state_cache_->Effort ( index );
     }
     joint_state_publisher_.publish ( joint_state_ );
 }
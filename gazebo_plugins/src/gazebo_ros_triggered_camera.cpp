@@ -18,7 +18,9 @@
 #include "gazebo_plugins/gazebo_ros_triggered_camera.h"
 
 #include <float.h>
+#include <algorithm>
 #include <string>
+#include <vector>
 
 #include <gazebo/sensors/Sensor.hh>
 #include <gazebo/sensors/CameraSensor.hh>
@@ -44,6 +46,8 @@ GazeboRosTriggeredCamera::GazeboRosTriggeredCamera()
 // Destructor
 GazeboRosTriggeredCamera::~GazeboRosTriggeredCamera()
 {
+  if (!this->trigger_group_.empty())
+    GazeboRosTriggeredCameraGroups::Instance().Remove(this);
   ROS_DEBUG_STREAM_NAMED("camera","Unloaded");
 }
 
@@ -67,6 +71,7 @@ void GazeboRosTriggeredCamera::Load(sensors::SensorPtr _parent, sdf::ElementPtr
   this->camera_ = this->camera;
 
   GazeboRosCameraUtils::Load(_parent, _sdf);
+  this->LoadTriggerGroup(_sdf);
 
   this->SetCameraEnabled(false);
   this->preRenderConnection_ =
@@ -80,6 +85,7 @@ void GazeboRosTriggeredCamera::Load(sensors::SensorPtr _parent,
   double _hack_baseline)
 {
   GazeboRosCameraUtils::Load(_parent, _sdf, _camera_name_suffix, _hack_baseline);
+  this->LoadTriggerGroup(_sdf);
 
   this->SetCameraEnabled(false);
   this->preRenderConnection_ =
@@ -112,6 +118,12 @@ void GazeboRosTriggeredCamera::OnNewFrame(const unsigned char *_image,
 #ifdef ENABLE_PROFILER
     IGN_PROFILE_END();
 #endif
+
+    if (!this->trigger_group_.empty())
+    {
+      GazeboRosTriggeredCameraGroups::Instance().Published(
+          this->trigger_group_, this->CameraName());
+    }
   }
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_BEGIN("SetCameraEnabled");
@@ -120,8 +132,23 @@ void GazeboRosTriggeredCamera::OnNewFrame(const unsigned char *_image,
 #ifdef ENABLE_PROFILER
   IGN_PROFILE_END();
 #endif
-  std::lock_guard<std::mutex> lock(this->mutex);
-  this->triggered = std::max(this->triggered-1, 0);
+  {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->triggered = std::max(this->triggered-1, 0);
+  }
+}
+
+void GazeboRosTriggeredCamera::LoadTriggerGroup(sdf::ElementPtr _sdf)
+{
+  if (!_sdf->HasElement("triggerGroup"))
+    return;
+
+  this->trigger_group_ = _sdf->Get<std::string>("triggerGroup");
+  if (!this->trigger_group_.empty())
+  {
+    GazeboRosTriggeredCameraGroups::Instance().Add(this->trigger_group_,
+        this);
+  }
 }
 
 void GazeboRosTriggeredCamera::TriggerCamera()
@@ -152,4 +179,73 @@ void GazeboRosTriggeredCamera::SetCameraEnabled(const bool _enabled)
   this->parentSensor_->SetUpdateRate(_enabled ? 0.0 : DBL_MIN);
 }
 
+void GazeboRosTriggeredCamera::TriggerAndEnable()
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  if (!this->parentSensor_)
+    return;
+  this->triggered++;
+  this->SetCameraEnabled(true);
+}
+
+std::string GazeboRosTriggeredCamera::CameraName() const
+{
+  return this->camera_->Name();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+GazeboRosTriggeredCameraGroups &GazeboRosTriggeredCameraGroups::Instance()
+{
+  static GazeboRosTriggeredCameraGroups instance;
+  return instance;
+}
+
+void GazeboRosTriggeredCameraGroups::Add(const std::string &_group,
+    GazeboRosTriggeredCamera *_camera)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  this->groups[_group].push_back(_camera);
+}
+
+void GazeboRosTriggeredCameraGroups::Remove(GazeboRosTriggeredCamera *_camera)
+{
+  std::lock_guard<std::mutex> lock(this->mutex);
+  for (auto &group : this->groups)
+  {
+    group.second.erase(
+        std::remove(group.second.begin(), group.second.end(), _camera),
+        group.second.end());
+  }
+}
+
+std::vector<std::string> GazeboRosTriggeredCameraGroups::Trigger(
+    const std::string &_group)
+{
+  std::vector<std::string> names;
+  std::lock_guard<std::mutex> lock(this->mutex);
+  auto group = this->groups.find(_group);
+  if (group == this->groups.end())
+    return names;
+
+  names.reserve(group->second.size());
+  for (GazeboRosTriggeredCamera *camera : group->second)
+  {
+    camera->TriggerAndEnable();
+    names.push_back(camera->CameraName());
+  }
+  return names;
+}
+
+void GazeboRosTriggeredCameraGroups::Published(const std::string &_group,
+    const std::string &_camera)
+{
+  this->published(_group, _camera);
+}
+
+event::ConnectionPtr GazeboRosTriggeredCameraGroups::ConnectPublished(
+    std::function<void(const std::string &, const std::string &)> _subscriber)
+{
+  return this->published.Connect(_subscriber);
+}
+
 }
@@ -32,28 +32,16 @@
 *  POSSIBILITY OF SUCH DAMAGE.
 *********************************************************************/
 
-#include <dynamic_reconfigure/server.h>
-#include <gazebo_plugins/HokuyoConfig.h>
-
-void callback(gazebo_plugins::HokuyoConfig &config, uint32_t level)
-{
-  ROS_INFO_NAMED("hokuyo_node", "Reconfigure request : %f %f %i %i %i %s %i %s %f %i",
-           config.min_ang, config.max_ang, (int)config.intensity, config.cluster, config.skip,
-           config.port.c_str(), (int)config.calibrate_time, config.frame_id.c_str(), config.time_offset, (int)config.allow_unsafe_settings);
-
-  // do nothing for now
-
-  ROS_INFO_NAMED("hokuyo_node", "Reconfigure to : %f %f %i %i %i %s %i %s %f %i",
-           config.min_ang, config.max_ang, (int)config.intensity, config.cluster, config.skip,
-           config.port.c_str(), (int)config.calibrate_time, config.frame_id.c_str(), config.time_offset, (int)config.allow_unsafe_settings);
-}
+#include <gazebo_plugins/hokuyo_relay.h>
 
 int main(int argc, char **argv)
 {
   ros::init(argc, argv, "hokuyo_node");
-  dynamic_reconfigure::Server<gazebo_plugins::HokuyoConfig> srv;
-  dynamic_reconfigure::Server<gazebo_plugins::HokuyoConfig>::CallbackType f = boost::bind(&callback, _1, _2);
-  srv.setCallback(f);
+
+  // same relay as the gazebo_plugins/HokuyoNodelet nodelet, which avoids
+  // copying scans when loaded into the manager of its subscribers
+  gazebo_plugins::HokuyoRelay relay(ros::NodeHandle(), ros::NodeHandle("~"));
+
   ROS_INFO_NAMED("hokuyo_node", "Starting to spin...");
   ros::spin();
   return 0;
@@ -0,0 +1,257 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <pluginlib/class_list_macros.h>
+
+#include <gazebo_plugins/hokuyo_relay.h>
+
+namespace gazebo_plugins
+{
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+HokuyoRelay::HokuyoRelay(ros::NodeHandle nh, ros::NodeHandle private_nh) :
+  nh_(nh), config_(HokuyoConfig::__getDefault__()), skipped_(0)
+{
+  this->srv_.reset(new dynamic_reconfigure::Server<HokuyoConfig>(private_nh));
+  dynamic_reconfigure::Server<HokuyoConfig>::CallbackType f =
+    boost::bind(&HokuyoRelay::ReconfigureCallback, this, _1, _2);
+  this->srv_->setCallback(f);
+
+  ros::AdvertiseOptions ao =
+    ros::AdvertiseOptions::create<sensor_msgs::LaserScan>(
+    "scan", 1,
+    boost::bind(&HokuyoRelay::ScanConnect, this),
+    boost::bind(&HokuyoRelay::ScanDisconnect, this),
+    ros::VoidPtr(), NULL);
+  this->pub_ = this->nh_.advertise(ao);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Apply new reconfigure parameters
+void HokuyoRelay::ReconfigureCallback(HokuyoConfig &config, uint32_t level)
+{
+  boost::mutex::scoped_lock lock(this->lock_);
+
+  if (config.min_ang > config.max_ang)
+  {
+    ROS_WARN_NAMED("hokuyo_node", "min_ang %f is larger than max_ang %f, "
+      "keeping the previous window", config.min_ang, config.max_ang);
+    config.min_ang = this->config_.min_ang;
+    config.max_ang = this->config_.max_ang;
+  }
+
+  ROS_INFO_NAMED("hokuyo_node", "Reconfigure to : %f %f %i %i %i %s %f",
+           config.min_ang, config.max_ang, (int)config.intensity, config.cluster,
+           config.skip, config.frame_id.c_str(), config.time_offset);
+
+  this->config_ = config;
+  this->skipped_ = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Subscribe to the simulated scan
+void HokuyoRelay::ScanConnect()
+{
+  boost::mutex::scoped_lock lock(this->connect_lock_);
+  if (!this->sub_)
+    this->sub_ = this->nh_.subscribe("scan_in", 1, &HokuyoRelay::OnScan, this);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Unsubscribe from the simulated scan
+void HokuyoRelay::ScanDisconnect()
+{
+  boost::mutex::scoped_lock lock(this->connect_lock_);
+  if (this->pub_.getNumSubscribers() == 0)
+    this->sub_.shutdown();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reduce and republish a scan
+void HokuyoRelay::OnScan(const sensor_msgs::LaserScan::ConstPtr &scan)
+{
+  boost::mutex::scoped_lock lock(this->lock_);
+
+  if (this->skipped_ < this->config_.skip)
+  {
+    ++this->skipped_;
+    return;
+  }
+  this->skipped_ = 0;
+
+  if (IsPassThrough(*scan, this->config_))
+  {
+    // same message, intra-process subscribers get the sensor's pointer
+    this->pub_.publish(scan);
+    return;
+  }
+
+  MessagePool<sensor_msgs::LaserScan>::MessagePtr out =
+    this->scan_pool_.acquire(scan->ranges.size() * sizeof(float));
+  if (!FilterScan(*scan, this->config_, *out))
+  {
+    ROS_WARN_THROTTLE_NAMED(10, "hokuyo_node", "No ray of the scan from "
+      "%f to %f is within min_ang %f and max_ang %f", scan->angle_min,
+      scan->angle_max, this->config_.min_ang, this->config_.max_ang);
+    return;
+  }
+  this->pub_.publish(out);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Whether the scan is published as it is
+bool HokuyoRelay::IsPassThrough(const sensor_msgs::LaserScan &in,
+                                const HokuyoConfig &config)
+{
+  const double eps = 1e-5;
+  return config.cluster <= 1 && config.skip == 0 &&
+    config.time_offset == 0.0 &&
+    (config.frame_id.empty() || config.frame_id == in.header.frame_id) &&
+    (config.intensity || in.intensities.empty()) &&
+    (in.angle_increment <= 0.0 ||
+     (in.angle_min >= config.min_ang - eps &&
+      in.angle_max <= config.max_ang + eps));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Reduce a scan to the configured window and clusters
+bool HokuyoRelay::FilterScan(const sensor_msgs::LaserScan &in,
+                             const HokuyoConfig &config,
+                             sensor_msgs::LaserScan &out)
+{
+  const size_t n = in.ranges.size();
+  if (n == 0)
+    return false;
+
+  // first and last ray within [min_ang, max_ang], a scan without a
+  // positive increment is kept whole
+  size_t first = 0;
+  size_t last = n - 1;
+  if (in.angle_increment > 0.0)
+  {
+    // tolerance in rays for angles stored as float
+    const double eps = 1e-3;
+    const double lo =
+      std::ceil((config.min_ang - in.angle_min) / in.angle_increment - eps);
+    const double hi =
+      std::floor((config.max_ang - in.angle_min) / in.angle_increment + eps);
+    if (hi < 0.0 || lo > static_cast<double>(n - 1) || lo > hi)
+      return false;
+    first = lo > 0.0 ? static_cast<size_t>(lo) : 0;
+    last = std::min(static_cast<size_t>(hi), n - 1);
+  }
+
+  // a trailing partial cluster becomes a reading of its own
+  const size_t span = last - first + 1;
+  const size_t cluster = config.cluster > 1 ? config.cluster : 1;
+  const size_t count = (span + cluster - 1) / cluster;
+
+  out.header = in.header;
+  if (!config.frame_id.empty())
+    out.header.frame_id = config.frame_id;
+  if (in.header.stamp.toSec() + config.time_offset > 0.0)
+    out.header.stamp = in.header.stamp + ros::Duration(config.time_offset);
+  else
+    out.header.stamp = ros::Time(0);
+
+  out.angle_min = in.angle_min + first * in.angle_increment;
+  out.angle_increment = in.angle_increment * cluster;
+  out.angle_max = out.angle_min + (count - 1) * out.angle_increment;
+  out.time_increment = in.time_increment * cluster;
+  out.scan_time = in.scan_time * (config.skip + 1);
+  out.range_min = in.range_min;
+  out.range_max = in.range_max;
+
+  const bool intensities = config.intensity && in.intensities.size() == n;
+  out.ranges.resize(count);
+  if (intensities)
+    out.intensities.resize(count);
+  else
+    out.intensities.clear();
+
+  const float *ranges = &in.ranges[first];
+  float *out_ranges = &out.ranges[0];
+
+  if (cluster == 1)
+  {
+    std::copy(ranges, ranges + count, out_ranges);
+    if (intensities)
+      std::copy(&in.intensities[first], &in.intensities[first] + count,
+                &out.intensities[0]);
+    return true;
+  }
+
+  // each reading is the closest valid range of its cluster like on the
+  // device, ranges below range_min and NaN are skipped and a cluster
+  // without a valid range reads +Inf (no return).  The k-th rays of all
+  // clusters are merged at once, so that the inner loops select without
+  // branches over consecutive readings and the compiler vectorizes them.
+  std::fill(out_ranges, out_ranges + count,
+            std::numeric_limits<float>::infinity());
+  const float range_min = in.range_min;
+  if (!intensities)
+  {
+    for (size_t k = 0; k < cluster && k < span; ++k)
+    {
+      // readings whose cluster holds a k-th ray
+      const size_t readings = (span - k + cluster - 1) / cluster;
+      for (size_t i = 0; i < readings; ++i)
+      {
+        const float r = ranges[i * cluster + k];
+        const float best = out_ranges[i];
+        out_ranges[i] = (r >= range_min && r < best) ? r : best;
+      }
+    }
+  }
+  else
+  {
+    const float *in_intensities = &in.intensities[first];
+    float *out_intensities = &out.intensities[0];
+    std::fill(out_intensities, out_intensities + count, 0.0f);
+    for (size_t k = 0; k < cluster && k < span; ++k)
+    {
+      const size_t readings = (span - k + cluster - 1) / cluster;
+      for (size_t i = 0; i < readings; ++i)
+      {
+        const float r = ranges[i * cluster + k];
+        const float best = out_ranges[i];
+        const bool closer = r >= range_min && r < best;
+        out_ranges[i] = closer ? r : best;
+        out_intensities[i] =
+          closer ? in_intensities[i * cluster + k] : out_intensities[i];
+      }
+    }
+  }
+  return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Create the relay
+void HokuyoNodelet::onInit()
+{
+  this->relay_.reset(
+    new HokuyoRelay(this->getNodeHandle(), this->getPrivateNodeHandle()));
+}
+
+}
+
+PLUGINLIB_EXPORT_CLASS(gazebo_plugins::HokuyoNodelet, nodelet::Nodelet)
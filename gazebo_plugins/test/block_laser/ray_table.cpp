@@ -0,0 +1,175 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gazebo_plugins/BlockLaserRayTable.h>
+
+#include <cmath>
+#include <vector>
+
+// Ray configuration of a block laser
+struct BlockScan
+{
+  int rays, ranges;
+  double min_angle, max_angle;
+  int vertical_rays, vertical_ranges;
+  double vertical_min_angle, vertical_max_angle;
+  std::vector<double> range, retro;
+
+  // ray k reads a smooth but uneven range and retro value
+  BlockScan(int _rays, int _ranges, int _vertical_rays, int _vertical_ranges)
+    : rays(_rays), ranges(_ranges), min_angle(-0.8), max_angle(0.6),
+      vertical_rays(_vertical_rays), vertical_ranges(_vertical_ranges),
+      vertical_min_angle(-0.3), vertical_max_angle(0.2)
+  {
+    for (int k = 0; k < rays * vertical_rays; ++k)
+    {
+      range.push_back(1.0 + 0.5 * sin(0.7 * k) + 0.01 * k);
+      retro.push_back(100.0 * (k % 7));
+    }
+  }
+};
+
+// Output point (i, j) as the plugin computed it before the tables
+static void OldPoint(const BlockScan &s, int i, int j, double &r,
+                     double &intensity, double &yAngle, double &pAngle)
+{
+  double vb = (s.vertical_ranges == 1) ? 0 :
+    (double) j * (s.vertical_rays - 1) / (s.vertical_ranges - 1);
+  int vja = (int) floor(vb);
+  int vjb = std::min(vja + 1, s.vertical_rays - 1);
+  vb = vb - floor(vb);
+
+  double hb = (s.ranges == 1) ? 0 : (double) i * (s.rays - 1) / (s.ranges - 1);
+  int hja = (int) floor(hb);
+  int hjb = std::min(hja + 1, s.rays - 1);
+  hb = hb - floor(hb);
+
+  int j1 = hja + vja * s.rays;
+  int j2 = hjb + vja * s.rays;
+  int j3 = hja + vjb * s.rays;
+  int j4 = hjb + vjb * s.rays;
+
+  r = (1-vb)*((1 - hb) * s.range[j1] + hb * s.range[j2])
+     +   vb *((1 - hb) * s.range[j3] + hb * s.range[j4]);
+  intensity = 0.25*(s.retro[j1] + s.retro[j2] + s.retro[j3] + s.retro[j4]);
+
+  double yDiff = s.max_angle - s.min_angle;
+  double pDiff = s.vertical_max_angle - s.vertical_min_angle;
+  yAngle = 0.5*(hja+hjb) * yDiff / (s.rays -1) + s.min_angle;
+  pAngle = 0.5*(vja+vjb) * pDiff / (s.vertical_rays -1) + s.vertical_min_angle;
+}
+
+// Compare every output point of a scan against the old computation
+static void ExpectSameAsOld(const BlockScan &s, const BlockLaserRayTable &h,
+                            const BlockLaserRayTable &v)
+{
+  ASSERT_EQ(s.ranges, h.size());
+  ASSERT_EQ(s.vertical_ranges, v.size());
+
+  for (int j = 0; j < s.vertical_ranges; ++j)
+  {
+    for (int i = 0; i < s.ranges; ++i)
+    {
+      double r, intensity;
+      BlockLaserRayTable::interpolate(h, v, &s.range[0], &s.retro[0], i, j,
+                                      r, intensity);
+
+      double old_r, old_intensity, yAngle, pAngle;
+      OldPoint(s, i, j, old_r, old_intensity, yAngle, pAngle);
+      EXPECT_NEAR(old_r, r, 1e-12) << "point " << i << ", " << j;
+      EXPECT_NEAR(old_intensity, intensity, 1e-9) << "point " << i << ", " << j;
+      EXPECT_NEAR(cos(yAngle), h.cosAngle(i), 1e-12);
+      EXPECT_NEAR(sin(yAngle), h.sinAngle(i), 1e-12);
+      EXPECT_NEAR(cos(pAngle), v.cosAngle(j), 1e-12);
+      EXPECT_NEAR(sin(pAngle), v.sinAngle(j), 1e-12);
+    }
+  }
+}
+
+static void ExpectSameAsOld(const BlockScan &s)
+{
+  BlockLaserRayTable h, v;
+  h.update(s.rays, s.ranges, s.min_angle, s.max_angle);
+  v.update(s.vertical_rays, s.vertical_ranges,
+           s.vertical_min_angle, s.vertical_max_angle);
+  ExpectSameAsOld(s, h, v);
+}
+
+// As many output points as rays
+TEST(BlockLaserRayTable, oneToOne)
+{
+  ExpectSameAsOld(BlockScan(20, 20, 4, 4));
+}
+
+// More output points than rays
+TEST(BlockLaserRayTable, upsampled)
+{
+  ExpectSameAsOld(BlockScan(10, 37, 3, 8));
+}
+
+// Fewer output points than rays
+TEST(BlockLaserRayTable, downsampled)
+{
+  ExpectSameAsOld(BlockScan(64, 15, 16, 5));
+}
+
+// A reused table follows a change of the ray configuration
+TEST(BlockLaserRayTable, rebuiltOnChange)
+{
+  BlockScan s(10, 37, 3, 8);
+  BlockLaserRayTable h, v;
+  h.update(s.rays, s.ranges, s.min_angle, s.max_angle);
+  v.update(s.vertical_rays, s.vertical_ranges,
+           s.vertical_min_angle, s.vertical_max_angle);
+  ExpectSameAsOld(s, h, v);
+
+  s.ranges = 12;
+  s.max_angle = 0.9;
+  h.update(s.rays, s.ranges, s.min_angle, s.max_angle);
+  ExpectSameAsOld(s, h, v);
+}
+
+// A single ring lies at the minimum angle, the old code divided by zero
+TEST(BlockLaserRayTable, singleRing)
+{
+  BlockScan s(30, 30, 1, 1);
+  BlockLaserRayTable h, v;
+  h.update(s.rays, s.ranges, s.min_angle, s.max_angle);
+  v.update(s.vertical_rays, s.vertical_ranges,
+           s.vertical_min_angle, s.vertical_max_angle);
+
+  for (int i = 0; i < s.ranges; ++i)
+  {
+    double r, intensity;
+    BlockLaserRayTable::interpolate(h, v, &s.range[0], &s.retro[0], i, 0,
+                                    r, intensity);
+    double old_r, old_intensity, yAngle, pAngle;
+    OldPoint(s, i, 0, old_r, old_intensity, yAngle, pAngle);
+    EXPECT_DOUBLE_EQ(old_r, r);
+    EXPECT_DOUBLE_EQ(old_intensity, intensity);
+    EXPECT_DOUBLE_EQ(cos(yAngle), h.cosAngle(i));
+  }
+  EXPECT_DOUBLE_EQ(cos(s.vertical_min_angle), v.cosAngle(0));
+  EXPECT_DOUBLE_EQ(sin(s.vertical_min_angle), v.sinAngle(0));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
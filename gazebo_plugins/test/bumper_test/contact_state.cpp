@@ -0,0 +1,126 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gazebo_plugins/gazebo_ros_bumper.h>
+
+using gazebo::GazeboRosBumper;
+
+// two points of a box resting on the ground, the box is collision1 and
+// ground collision2, each body gets the opposite wrench
+static gazebo::msgs::Contact MakeContact()
+{
+  gazebo::msgs::Contact contact;
+  contact.set_collision1("box::link::collision");
+  contact.set_collision2("ground::link::collision");
+  for (int j = 0; j < 2; ++j)
+  {
+    gazebo::msgs::Set(contact.add_position(),
+                      ignition::math::Vector3d(j, 0.0, 0.0));
+    gazebo::msgs::Set(contact.add_normal(),
+                      ignition::math::Vector3d(0.0, 0.0, 1.0));
+    contact.add_depth(0.001 * (j + 1));
+
+    gazebo::msgs::JointWrench *wrench = contact.add_wrench();
+    wrench->set_body_1_name("box::link");
+    wrench->set_body_1_id(1);
+    wrench->set_body_2_name("ground::link");
+    wrench->set_body_2_id(2);
+    gazebo::msgs::Set(wrench->mutable_body_1_wrench()->mutable_force(),
+                      ignition::math::Vector3d(0.1, 0.0, 5.0));
+    gazebo::msgs::Set(wrench->mutable_body_1_wrench()->mutable_torque(),
+                      ignition::math::Vector3d(0.0, 0.2, 0.0));
+    gazebo::msgs::Set(wrench->mutable_body_2_wrench()->mutable_force(),
+                      ignition::math::Vector3d(-0.1, 0.0, -5.0));
+    gazebo::msgs::Set(wrench->mutable_body_2_wrench()->mutable_torque(),
+                      ignition::math::Vector3d(0.0, -0.3, 0.0));
+  }
+  return contact;
+}
+
+// the pair as reported, from collision1
+TEST(ContactStateTest, fill)
+{
+  const gazebo::msgs::Contact contact = MakeContact();
+  gazebo_msgs::ContactState state;
+  GazeboRosBumper::FillContactState(contact, ignition::math::Pose3d(), state);
+
+  EXPECT_EQ("box::link::collision", state.collision1_name);
+  EXPECT_EQ("ground::link::collision", state.collision2_name);
+  ASSERT_EQ(2u, state.wrenches.size());
+  EXPECT_DOUBLE_EQ(5.0, state.wrenches[1].force.z);
+  EXPECT_DOUBLE_EQ(10.0, state.total_wrench.force.z);
+  EXPECT_DOUBLE_EQ(0.4, state.total_wrench.torque.y);
+  ASSERT_EQ(2u, state.contact_normals.size());
+  EXPECT_DOUBLE_EQ(1.0, state.contact_normals[0].z);
+  EXPECT_DOUBLE_EQ(1.0, state.contact_positions[1].x);
+}
+
+// a model that is collision2 of the pair gets the wrench on its body and
+// the reversed normal
+TEST(ContactStateTest, fillSwapped)
+{
+  const gazebo::msgs::Contact contact = MakeContact();
+  gazebo_msgs::ContactState state;
+  GazeboRosBumper::FillContactState(contact, ignition::math::Pose3d(), state,
+                                    true);
+
+  EXPECT_EQ("ground::link::collision", state.collision1_name);
+  EXPECT_EQ("box::link::collision", state.collision2_name);
+  ASSERT_EQ(2u, state.wrenches.size());
+  EXPECT_DOUBLE_EQ(-5.0, state.wrenches[1].force.z);
+  EXPECT_DOUBLE_EQ(-0.1, state.wrenches[1].force.x);
+  EXPECT_DOUBLE_EQ(-10.0, state.total_wrench.force.z);
+  EXPECT_DOUBLE_EQ(-0.6, state.total_wrench.torque.y);
+  ASSERT_EQ(2u, state.contact_normals.size());
+  EXPECT_DOUBLE_EQ(-1.0, state.contact_normals[0].z);
+  EXPECT_DOUBLE_EQ(-1.0, state.contact_normals[1].z);
+  EXPECT_DOUBLE_EQ(1.0, state.contact_positions[1].x);
+  EXPECT_DOUBLE_EQ(0.002, state.depths[1]);
+}
+
+// the aggregated reading of a swapped pair
+TEST(ContactStateTest, aggregateSwapped)
+{
+  const gazebo::msgs::Contact contact = MakeContact();
+  gazebo_msgs::ContactState state;
+  GazeboRosBumper::AggregateContactState(contact, ignition::math::Pose3d(),
+                                         state, false);
+  EXPECT_EQ("box::link::collision", state.collision1_name);
+  EXPECT_DOUBLE_EQ(10.0, state.total_wrench.force.z);
+  ASSERT_EQ(1u, state.contact_normals.size());
+  EXPECT_DOUBLE_EQ(1.0, state.contact_normals[0].z);
+
+  GazeboRosBumper::AggregateContactState(contact, ignition::math::Pose3d(),
+                                         state, true);
+  EXPECT_EQ("ground::link::collision", state.collision1_name);
+  EXPECT_EQ("box::link::collision", state.collision2_name);
+  EXPECT_DOUBLE_EQ(-10.0, state.total_wrench.force.z);
+  EXPECT_DOUBLE_EQ(-0.6, state.total_wrench.torque.y);
+  ASSERT_EQ(1u, state.wrenches.size());
+  EXPECT_DOUBLE_EQ(-10.0, state.wrenches[0].force.z);
+  ASSERT_EQ(1u, state.contact_normals.size());
+  EXPECT_DOUBLE_EQ(-1.0, state.contact_normals[0].z);
+  EXPECT_DOUBLE_EQ(0.5, state.contact_positions[0].x);
+  EXPECT_DOUBLE_EQ(0.002, state.depths[0]);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+/*
+ * Desc: Times the conversion of the contacts of a settled world to a
+ *       gazebo_msgs/ContactsState message, as done by gazebo_ros_bumper
+ *       in its raw and aggregated output modes.
+ *
+ *   contacts_benchmark `rospack find gazebo_plugins`/test2/lcp_tests/stacks_contacts.world
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+#include <gazebo/gazebo.hh>
+#include <gazebo/physics/physics.hh>
+
+#include <gazebo_plugins/gazebo_ros_bumper.h>
+
+/// \brief Average time of one call of f in microseconds
+template<class F>
+static double TimeIt(F f, int iterations)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    f();
+  std::chrono::duration<double, std::micro> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "usage: %s <world file> [iterations] [settle steps]\n",
+            argv[0]);
+    return 1;
+  }
+  const int iterations = argc > 2 ? atoi(argv[2]) : 1000;
+  const int settle_steps = argc > 3 ? atoi(argv[3]) : 500;
+
+  gazebo::setupServer();
+  gazebo::physics::WorldPtr world = gazebo::loadWorld(argv[1]);
+  if (!world)
+  {
+    fprintf(stderr, "could not load world %s\n", argv[1]);
+    return 1;
+  }
+
+  // keep contacts without a contact sensor subscribed, then let the
+  // stacks settle
+  gazebo::physics::ContactManager *manager =
+    world->Physics()->GetContactManager();
+  manager->SetNeverDropContacts(true);
+  gazebo::runWorld(world, settle_steps);
+
+  // the contacts of the last step, as a contact sensor reports them
+  gazebo::msgs::Contacts contacts;
+  const std::vector<gazebo::physics::Contact *> &world_contacts =
+    manager->GetContacts();
+  int points = 0;
+  for (unsigned int i = 0; i < manager->GetContactCount(); ++i)
+  {
+    world_contacts[i]->FillMsg(*contacts.add_contact());
+    points += world_contacts[i]->count;
+  }
+
+  const ignition::math::Pose3d frame_pose;
+
+  // a message reused across updates, as taken from the plugin's pool
+  gazebo_msgs::ContactsState reused_msg;
+  const double reused_us = TimeIt([&]()
+    {
+      gazebo::GazeboRosBumper::FillContactsState(contacts, frame_pose,
+                                                  reused_msg);
+    }, iterations);
+
+  // a new message per update
+  const double fresh_us = TimeIt([&]()
+    {
+      gazebo_msgs::ContactsState msg;
+      gazebo::GazeboRosBumper::FillContactsState(contacts, frame_pose, msg);
+    }, iterations);
+
+  // one reading per collision pair
+  gazebo_msgs::ContactsState aggregated_msg;
+  const double aggregated_us = TimeIt([&]()
+    {
+      gazebo::GazeboRosBumper::AggregateContactsState(contacts, frame_pose,
+                                                       aggregated_msg);
+    }, iterations);
+
+  printf("%d collision pairs, %d contact points, %d iterations\n",
+         contacts.contact_size(), points, iterations);
+  printf("reused message: %10.2f us per update, %8.3f us per point\n",
+         reused_us, points > 0 ? reused_us / points : 0.0);
+  printf("new message:    %10.2f us per update, %8.3f us per point\n",
+         fresh_us, points > 0 ? fresh_us / points : 0.0);
+  printf("aggregated:     %10.2f us per update, %8.3f us per point\n",
+         aggregated_us, points > 0 ? aggregated_us / points : 0.0);
+
+  gazebo::shutdown();
+  return 0;
+}
@@ -1,7 +1,9 @@
+#include <cmath>
 #include <gtest/gtest.h>
 #include <image_transport/image_transport.h>
 #include <ros/ros.h>
 #include <sensor_msgs/PointCloud2.h>
+#include <stereo_msgs/DisparityImage.h>
 
 class DepthCameraTest : public testing::Test
 {
@@ -11,6 +13,7 @@ protected:
     has_new_image_ = false;
     has_new_depth_ = false;
     has_new_points_ = false;
+    has_new_disparity_ = false;
   }
 
   ros::NodeHandle nh_;
@@ -23,6 +26,9 @@ protected:
   ros::Time depth_stamp_;
   bool has_new_points_;
   ros::Time points_stamp_;
+  ros::Subscriber disparity_sub_;
+  bool has_new_disparity_;
+  ros::Time disparity_stamp_;
 public:
   void imageCallback(const sensor_msgs::ImageConstPtr& msg)
   {
@@ -39,6 +45,14 @@ public:
     points_stamp_ = msg->header.stamp;
     has_new_points_ = true;
   }
+  void disparityCallback(const stereo_msgs::DisparityImageConstPtr& msg)
+  {
+    disparity_stamp_ = msg->header.stamp;
+    EXPECT_GT(msg->f, 0.0);
+    EXPECT_GT(msg->T, 0.0);
+    EXPECT_EQ(msg->image.data.size(), msg->image.step * msg->image.height);
+    has_new_disparity_ = true;
+  }
 };
 
 // Test if the camera image is published at all, and that the timestamp
@@ -120,6 +134,32 @@ TEST_F(DepthCameraTest, cameraSubscribeTest)
   }
 }
 
+// Test if the disparity image is published alongside the depth image.
+TEST_F(DepthCameraTest, disparitySubscribeTest)
+{
+  image_transport::ImageTransport it(nh_);
+  depth_sub_ = it.subscribe("camera1/depth/image_raw", 1,
+                            &DepthCameraTest::depthCallback,
+                            dynamic_cast<DepthCameraTest*>(this));
+  disparity_sub_ = nh_.subscribe("camera1/depth/disparity", 1,
+                                 &DepthCameraTest::disparityCallback,
+                                 dynamic_cast<DepthCameraTest*>(this));
+
+  while (!has_new_depth_ || !has_new_disparity_)
+  {
+    ros::spinOnce();
+    ros::Duration(0.1).sleep();
+  }
+
+  // both are filled from the same depth frame, they may still come from
+  // different frames when the subscriptions started in between
+  const double max_time = 1.0;
+  EXPECT_LT(fabs((depth_stamp_ - disparity_stamp_).toSec()), max_time);
+
+  depth_sub_.shutdown();
+  disparity_sub_.shutdown();
+}
+
 int main(int argc, char** argv)
 {
   ros::init(argc, argv, "gazebo_depth_camera_test");
@@ -44,10 +44,12 @@ class DistortionTest : public testing::Test
   // Used to listen for images
   image_transport::Subscriber cam_sub_distorted_;
   image_transport::Subscriber cam_sub_undistorted_;
+  image_transport::Subscriber cam_sub_rectified_;
 
   // Stores found images
   sensor_msgs::ImageConstPtr cam_image_distorted_;
   sensor_msgs::ImageConstPtr cam_image_undistorted_;
+  sensor_msgs::ImageConstPtr cam_image_rectified_;
 
   // Listens for camera metadata to be published
   ros::Subscriber cam_info_distorted_sub_;
@@ -56,19 +58,24 @@ class DistortionTest : public testing::Test
 
  public:
   void cameraDistortionTest();
+  void cameraRectifiedTest();
 
   void imageCallback(const sensor_msgs::ImageConstPtr& msg, int cam_index)
   {
     // for now, only support 2 cameras
-    assert(cam_index == 0 || cam_index == 1);
+    assert(cam_index >= 0 && cam_index <= 2);
     if(cam_index == 0)
     {
       cam_image_undistorted_ = msg;
     }
-    else
+    else if(cam_index == 1)
     {
       cam_image_distorted_ = msg;
     }
+    else
+    {
+      cam_image_rectified_ = msg;
+    }
   }
   void camInfoCallback(const sensor_msgs::CameraInfoConstPtr& msg)
   {
@@ -182,4 +189,88 @@ void DistortionTest::cameraDistortionTest()
   }
 }
 
+// The rectified image published by the plugin should match the image of the
+// camera without distortion about as well as undistorting the distorted
+// image with OpenCV does.
+void DistortionTest::cameraRectifiedTest()
+{
+  ros::AsyncSpinner spinner(2);
+  spinner.start();
+
+  image_transport::ImageTransport trans(nh_);
+  cam_sub_undistorted_ =
+      trans.subscribe("/camera_undistorted/image_raw",
+                      1,
+                      boost::bind(&DistortionTest::imageCallback,
+                      dynamic_cast<DistortionTest*>(this), _1, 0)
+                     );
+  cam_sub_distorted_ =
+      trans.subscribe("/camera_distorted/image_raw",
+                      1,
+                      boost::bind(&DistortionTest::imageCallback,
+                      dynamic_cast<DistortionTest*>(this), _1, 1)
+                     );
+  cam_sub_rectified_ =
+      trans.subscribe("/camera_distorted/image_rect",
+                      1,
+                      boost::bind(&DistortionTest::imageCallback,
+                      dynamic_cast<DistortionTest*>(this), _1, 2)
+                     );
+  cam_info_distorted_sub_ =
+      nh_.subscribe("/camera_distorted/camera_info",
+                    1,
+                    &DistortionTest::camInfoCallback,
+                    dynamic_cast<DistortionTest*>(this)
+                   );
+
+  while (!cam_image_rectified_ || !cam_image_undistorted_ ||
+      !cam_image_distorted_ || !cam_info_distorted_)
+  {
+    ros::Duration(0.1).sleep();
+  }
+  cam_sub_undistorted_.shutdown();
+  cam_sub_distorted_.shutdown();
+  cam_sub_rectified_.shutdown();
+  cam_info_distorted_sub_.shutdown();
+
+  // load camera coefficients from published ROS information
+  Mat intrinsic_distorted_matrix = Mat(3, 3, CV_64F);
+  ASSERT_EQ(9u, cam_info_distorted_->K.size());
+  memcpy(intrinsic_distorted_matrix.data, cam_info_distorted_->K.data(),
+    cam_info_distorted_->K.size()*sizeof(double));
+  Mat distortion_coeffs = Mat(5, 1, CV_64F);
+  ASSERT_EQ(5u, cam_info_distorted_->D.size());
+  memcpy(distortion_coeffs.data, cam_info_distorted_->D.data(),
+    cam_info_distorted_->D.size()*sizeof(double));
+
+  Mat rectified = Mat(cv_bridge::toCvCopy(cam_image_rectified_)->image);
+  Mat distorted = Mat(cv_bridge::toCvCopy(cam_image_distorted_)->image);
+  Mat undistorted = Mat(cv_bridge::toCvCopy(cam_image_undistorted_)->image);
+  ASSERT_EQ(rectified.rows, undistorted.rows);
+  ASSERT_EQ(rectified.cols, undistorted.cols);
+  ASSERT_EQ(distorted.rows, undistorted.rows);
+  ASSERT_EQ(distorted.cols, undistorted.cols);
+
+  // baseline, the distorted image undistorted by OpenCV
+  Mat fixed;
+  undistort(distorted, fixed, intrinsic_distorted_matrix, distortion_coeffs);
+
+  //crop the image to remove black borders leftover from (un)distortion
+  int cropBorder = 50;
+  cv::Rect myROI(cropBorder, cropBorder,
+    rectified.cols - 2 * cropBorder, rectified.rows - 2 * cropBorder);
+  cv::Mat rectified_crop = rectified(myROI);
+  cv::Mat fixed_crop = fixed(myROI);
+  cv::Mat undistorted_crop = undistorted(myROI);
+
+  long diff = 0, baseline_diff = 0;
+  diffBetween(rectified_crop, undistorted_crop, diff);
+  diffBetween(fixed_crop, undistorted_crop, baseline_diff);
+
+  // the bilinear table may round differently from OpenCV, allow 10% more
+  // difference plus one intensity level per channel
+  EXPECT_LE(diff, baseline_diff + baseline_diff / 10 +
+    3 * rectified_crop.rows * rectified_crop.cols);
+}
+
 #endif
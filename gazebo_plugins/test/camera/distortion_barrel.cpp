@@ -5,6 +5,11 @@ TEST_F(DistortionTest, barrelDistortion)
   cameraDistortionTest();
 }
 
+TEST_F(DistortionTest, barrelRectified)
+{
+  cameraRectifiedTest();
+}
+
 int main(int argc, char** argv)
 {
   ros::init(argc, argv, "gazebo_camera_barrel_distortion_test");
@@ -6,6 +6,7 @@
 #include <message_filters/time_synchronizer.h>
 #include <ros/ros.h>
 #include <sensor_msgs/Image.h>
+#include <gazebo_msgs/MultiCameraFrame.h>
 
 class MultiCameraTest : public testing::Test
 {
@@ -40,6 +41,14 @@ public:
     image_right_stamp_ = right_msg->header.stamp;
     has_new_image_ = true;
   }
+
+  void bundleCallback(const gazebo_msgs::MultiCameraFrameConstPtr& msg)
+  {
+    bundle_ = *msg;
+    has_new_image_ = true;
+  }
+
+  gazebo_msgs::MultiCameraFrame bundle_;
 };
 
 // Test if the camera image is published at all, and that the timestamp
@@ -108,6 +117,34 @@ TEST_F(MultiCameraTest, cameraSubscribeTest)
   }
 }
 
+// Test that the bundled output carries every camera with one shared stamp.
+TEST_F(MultiCameraTest, bundleSubscribeTest)
+{
+  ros::Subscriber bundle_sub = nh_.subscribe("stereo/camera/images", 1,
+      &MultiCameraTest::bundleCallback, dynamic_cast<MultiCameraTest*>(this));
+
+  while (!has_new_image_)
+  {
+    ros::spinOnce();
+    ros::Duration(0.1).sleep();
+  }
+
+  ASSERT_EQ(bundle_.images.size(), 2u);
+  ASSERT_EQ(bundle_.camera_infos.size(), 2u);
+  for (unsigned int i = 0; i < bundle_.images.size(); ++i)
+  {
+    EXPECT_EQ(bundle_.images[i].header.stamp, bundle_.header.stamp);
+    EXPECT_EQ(bundle_.camera_infos[i].header.stamp, bundle_.header.stamp);
+    EXPECT_EQ(bundle_.images[i].width, bundle_.camera_infos[i].width);
+    EXPECT_EQ(bundle_.images[i].height, bundle_.camera_infos[i].height);
+    EXPECT_FALSE(bundle_.images[i].data.empty());
+  }
+
+  double time_diff = (ros::Time::now() - bundle_.header.stamp).toSec();
+  EXPECT_LT(time_diff, 1.0);
+  bundle_sub.shutdown();
+}
+
 int main(int argc, char** argv)
 {
   ros::init(argc, argv, "gazebo_multicamera_test");
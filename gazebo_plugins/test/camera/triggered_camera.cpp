@@ -2,6 +2,8 @@
 #include <image_transport/image_transport.h>
 #include <ros/ros.h>
 #include <std_msgs/Empty.h>
+#include <std_msgs/String.h>
+#include <gazebo_msgs/CameraTriggerLatency.h>
 
 class TriggeredCameraTest : public testing::Test
 {
@@ -9,18 +11,27 @@ protected:
   virtual void SetUp()
   {
     images_received_ = 0;
+    latencies_received_ = 0;
   }
 
   ros::NodeHandle nh_;
   image_transport::Subscriber cam_sub_;
   int images_received_;
+  int latencies_received_;
   ros::Time image_stamp_;
+  gazebo_msgs::CameraTriggerLatency latency_;
 public:
   void imageCallback(const sensor_msgs::ImageConstPtr& msg)
   {
     image_stamp_ = msg->header.stamp;
     images_received_++;
   }
+
+  void latencyCallback(const gazebo_msgs::CameraTriggerLatencyConstPtr& msg)
+  {
+    latency_ = *msg;
+    latencies_received_++;
+  }
 };
 
 // Test if the camera image is published at all, and that the timestamp
@@ -106,6 +117,41 @@ TEST_F(TriggeredCameraTest, cameraSubscribeTest)
   cam_sub_.shutdown();
 }
 
+// Trigger the camera through its group on the world-level trigger broker and
+// check that the trigger-to-publish latency is reported.
+TEST_F(TriggeredCameraTest, groupTriggerTest)
+{
+  image_transport::ImageTransport it(nh_);
+  cam_sub_ = it.subscribe("camera1/image_raw", 5,
+                          &TriggeredCameraTest::imageCallback,
+                          dynamic_cast<TriggeredCameraTest*>(this));
+  ros::Subscriber latency_sub = nh_.subscribe("camera_trigger_latency", 5,
+      &TriggeredCameraTest::latencyCallback,
+      dynamic_cast<TriggeredCameraTest*>(this));
+
+  ros::Publisher trigger_pub =
+    nh_.advertise<std_msgs::String>("trigger_camera_group", 1, true);
+  std_msgs::String msg;
+  msg.data = "cameras";
+
+  trigger_pub.publish(msg);
+  for (unsigned int i = 0; i < 10 && !latencies_received_; ++i)
+  {
+    ros::spinOnce();
+    ros::Duration(0.1).sleep();
+  }
+  EXPECT_EQ(images_received_, 1);
+  ASSERT_EQ(latencies_received_, 1);
+  EXPECT_EQ(latency_.group, "cameras");
+  ASSERT_EQ(latency_.camera_names.size(), 1u);
+  ASSERT_EQ(latency_.real_latency.size(), 1u);
+  EXPECT_GE(latency_.real_latency[0], 0.0);
+  EXPECT_GE(latency_.sim_latency[0], 0.0);
+
+  latency_sub.shutdown();
+  cam_sub_.shutdown();
+}
+
 int main(int argc, char** argv)
 {
   ros::init(argc, argv, "gazebo_camera_test");
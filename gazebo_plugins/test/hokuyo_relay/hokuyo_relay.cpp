@@ -0,0 +1,131 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gazebo_plugins/hokuyo_relay.h>
+
+#include <cmath>
+#include <limits>
+
+using gazebo_plugins::HokuyoConfig;
+using gazebo_plugins::HokuyoRelay;
+
+// 181 rays from -pi/2 to pi/2, ray i reads 1 + i / 100
+static sensor_msgs::LaserScan MakeScan()
+{
+  sensor_msgs::LaserScan scan;
+  scan.header.frame_id = "laser";
+  scan.header.stamp = ros::Time(10.0);
+  scan.angle_min = -M_PI / 2;
+  scan.angle_increment = M_PI / 180;
+  scan.angle_max = scan.angle_min + 180 * scan.angle_increment;
+  scan.time_increment = 0.0001;
+  scan.scan_time = 0.025;
+  scan.range_min = 0.1;
+  scan.range_max = 30.0;
+  for (unsigned int i = 0; i < 181; ++i)
+  {
+    scan.ranges.push_back(1.0f + i / 100.0f);
+    scan.intensities.push_back(i);
+  }
+  return scan;
+}
+
+// the default window covers the scan, which is forwarded as it is
+TEST(HokuyoRelayTest, passThrough)
+{
+  sensor_msgs::LaserScan scan = MakeScan();
+  HokuyoConfig config = HokuyoConfig::__getDefault__();
+  config.intensity = true;
+  EXPECT_TRUE(HokuyoRelay::IsPassThrough(scan, config));
+
+  config.intensity = false;
+  EXPECT_FALSE(HokuyoRelay::IsPassThrough(scan, config));
+  scan.intensities.clear();
+  EXPECT_TRUE(HokuyoRelay::IsPassThrough(scan, config));
+
+  config.cluster = 2;
+  EXPECT_FALSE(HokuyoRelay::IsPassThrough(scan, config));
+  config.cluster = 1;
+  config.min_ang = 0.0;
+  EXPECT_FALSE(HokuyoRelay::IsPassThrough(scan, config));
+}
+
+// the window keeps the rays from min_ang to max_ang
+TEST(HokuyoRelayTest, window)
+{
+  sensor_msgs::LaserScan scan = MakeScan();
+  HokuyoConfig config = HokuyoConfig::__getDefault__();
+  config.min_ang = -M_PI / 4;
+  config.max_ang = 0.0;
+  config.frame_id = "hokuyo";
+  config.time_offset = 0.1;
+
+  sensor_msgs::LaserScan out;
+  ASSERT_TRUE(HokuyoRelay::FilterScan(scan, config, out));
+  ASSERT_EQ(46u, out.ranges.size());
+  EXPECT_FLOAT_EQ(scan.ranges[45], out.ranges[0]);
+  EXPECT_FLOAT_EQ(scan.ranges[90], out.ranges[45]);
+  EXPECT_NEAR(-M_PI / 4, out.angle_min, 1e-6);
+  EXPECT_NEAR(0.0, out.angle_max, 1e-6);
+  EXPECT_TRUE(out.intensities.empty());
+  EXPECT_EQ("hokuyo", out.header.frame_id);
+  EXPECT_NEAR(10.1, out.header.stamp.toSec(), 1e-9);
+
+  // a window beside the scan holds no ray
+  config.min_ang = M_PI * 0.75;
+  config.max_ang = M_PI;
+  EXPECT_FALSE(HokuyoRelay::FilterScan(scan, config, out));
+}
+
+// clusters read their closest valid range and its intensity
+TEST(HokuyoRelayTest, cluster)
+{
+  sensor_msgs::LaserScan scan = MakeScan();
+  scan.ranges[4] = 0.5f;
+  scan.ranges[5] = 0.01f;
+  scan.ranges[6] = std::numeric_limits<float>::quiet_NaN();
+  for (unsigned int i = 7; i < 10; ++i)
+    scan.ranges[i] = 0.0f;
+  HokuyoConfig config = HokuyoConfig::__getDefault__();
+  config.intensity = true;
+  config.cluster = 3;
+  config.skip = 1;
+
+  sensor_msgs::LaserScan out;
+  ASSERT_TRUE(HokuyoRelay::FilterScan(scan, config, out));
+
+  // 181 rays in 60 clusters and a trailing one of one ray
+  ASSERT_EQ(61u, out.ranges.size());
+  ASSERT_EQ(61u, out.intensities.size());
+  EXPECT_FLOAT_EQ(scan.ranges[0], out.ranges[0]);
+  EXPECT_FLOAT_EQ(0.0f, out.intensities[0]);
+  EXPECT_FLOAT_EQ(0.5f, out.ranges[1]);
+  EXPECT_FLOAT_EQ(4.0f, out.intensities[1]);
+  EXPECT_TRUE(std::isinf(out.ranges[2]));
+  EXPECT_FLOAT_EQ(scan.ranges[10], out.ranges[3]);
+  EXPECT_FLOAT_EQ(scan.ranges[180], out.ranges[60]);
+  EXPECT_NEAR(3 * scan.angle_increment, out.angle_increment, 1e-6);
+  EXPECT_NEAR(scan.angle_max, out.angle_max, 1e-6);
+  EXPECT_NEAR(2 * scan.scan_time, out.scan_time, 1e-9);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,183 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+#include <geometry_msgs/Twist.h>
+#include <ros/ros.h>
+#include <sensor_msgs/PointCloud2.h>
+#include <sensor_msgs/PointField.h>
+#include <sensor_msgs/point_cloud2_iterator.h>
+
+// Rays per scan and scans per assembled cloud in laser.world
+static const unsigned int kRays = 100;
+static const unsigned int kAssembledScans = 5;
+
+// x of the face of the wall and height of the lasers in laser.world
+static const double kWallX = 1.95;
+static const double kLaserZ = 0.5;
+
+// First ray angle and scan period of the lasers in laser.world
+static const double kAngleMin = -0.5;
+static const double kAngleStep = 1.0 / (kRays - 1);
+static const double kScanPeriod = 0.1;
+
+class LaserTest : public testing::Test
+{
+protected:
+  virtual void SetUp()
+  {
+    has_new_cloud_ = false;
+  }
+
+  ros::NodeHandle nh_;
+  ros::Subscriber cloud_sub_;
+  bool has_new_cloud_;
+  sensor_msgs::PointCloud2ConstPtr cloud_;
+public:
+  void cloudCallback(const sensor_msgs::PointCloud2ConstPtr& msg)
+  {
+    cloud_ = msg;
+    has_new_cloud_ = true;
+  }
+
+  // Wait for the next cloud, return false on timeout
+  bool waitForCloud(double timeout)
+  {
+    has_new_cloud_ = false;
+    ros::WallTime end = ros::WallTime::now() + ros::WallDuration(timeout);
+    while (!has_new_cloud_ && ros::ok() && ros::WallTime::now() < end)
+    {
+      ros::spinOnce();
+      ros::WallDuration(0.01).sleep();
+    }
+    return has_new_cloud_;
+  }
+
+  // Check name, offset and type of a field
+  void expectField(const sensor_msgs::PointCloud2& cloud, size_t i,
+                   const std::string& name, uint32_t offset, uint8_t datatype)
+  {
+    ASSERT_LT(i, cloud.fields.size());
+    EXPECT_EQ(name, cloud.fields[i].name);
+    EXPECT_EQ(offset, cloud.fields[i].offset);
+    EXPECT_EQ(datatype, cloud.fields[i].datatype);
+    EXPECT_EQ(1u, cloud.fields[i].count);
+  }
+};
+
+// The assembled cloud holds the last scans in the world frame, every ray
+// hits the wall.
+TEST_F(LaserTest, assembledCloudTest)
+{
+  cloud_sub_ = nh_.subscribe("laser/cloud", 1, &LaserTest::cloudCallback,
+                             dynamic_cast<LaserTest*>(this));
+
+  // the first clouds may be published before the ring is full
+  bool full = false;
+  for (int i = 0; i < 20 && !full; ++i)
+  {
+    ASSERT_TRUE(waitForCloud(10.0));
+    full = cloud_->width == kAssembledScans * kRays;
+  }
+  ASSERT_TRUE(full);
+  const sensor_msgs::PointCloud2& cloud = *cloud_;
+
+  EXPECT_EQ("world", cloud.header.frame_id);
+  EXPECT_EQ(1u, cloud.height);
+  EXPECT_TRUE(cloud.is_dense);
+  EXPECT_FALSE(cloud.is_bigendian);
+
+  // x, y, z, intensity
+  ASSERT_EQ(4u, cloud.fields.size());
+  expectField(cloud, 0, "x", 0, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 1, "y", 4, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 2, "z", 8, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 3, "intensity", 12, sensor_msgs::PointField::FLOAT32);
+  EXPECT_EQ(16u, cloud.point_step);
+  EXPECT_EQ(cloud.width * cloud.point_step, cloud.row_step);
+  EXPECT_EQ(cloud.row_step * cloud.height, cloud.data.size());
+
+  // the points lie on the wall
+  sensor_msgs::PointCloud2ConstIterator<float> x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<float> z(cloud, "z");
+  for (; x != x.end(); ++x, ++y, ++z)
+  {
+    EXPECT_NEAR(kWallX, *x, 0.01);
+    EXPECT_LT(std::abs(*y), kWallX * tan(0.5) + 0.01);
+    EXPECT_NEAR(kLaserZ, *z, 0.01);
+  }
+  cloud_sub_.shutdown();
+}
+
+// A laser turning at a constant rate casts its columns one after the
+// other. The time field grows across the scan and each column is rotated
+// back by the turn still ahead of it.
+TEST_F(LaserTest, rollingScanTest)
+{
+  const double rate = 2.0;
+  ros::Publisher cmd_pub = nh_.advertise<geometry_msgs::Twist>(
+    "rotating/cmd_vel", 1, true);
+  geometry_msgs::Twist cmd;
+  cmd.angular.z = rate;
+  cmd_pub.publish(cmd);
+
+  cloud_sub_ = nh_.subscribe("rotating/scan_rolling", 1,
+                             &LaserTest::cloudCallback,
+                             dynamic_cast<LaserTest*>(this));
+
+  // skip the clouds of the first sweep and of the laser speeding up
+  for (int i = 0; i < 10; ++i)
+    ASSERT_TRUE(waitForCloud(10.0));
+  const sensor_msgs::PointCloud2& cloud = *cloud_;
+
+  EXPECT_EQ("rotating_laser_link", cloud.header.frame_id);
+  EXPECT_EQ(kRays, cloud.width);
+  EXPECT_EQ(1u, cloud.height);
+  EXPECT_TRUE(cloud.is_dense);
+
+  // x, y, z, intensity, ring, time
+  ASSERT_EQ(6u, cloud.fields.size());
+  expectField(cloud, 0, "x", 0, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 1, "y", 4, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 2, "z", 8, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 3, "intensity", 12, sensor_msgs::PointField::FLOAT32);
+  expectField(cloud, 4, "ring", 16, sensor_msgs::PointField::UINT16);
+  expectField(cloud, 5, "time", 20, sensor_msgs::PointField::FLOAT32);
+  EXPECT_EQ(24u, cloud.point_step);
+  EXPECT_EQ(cloud.row_step * cloud.height, cloud.data.size());
+
+  // the columns are spread over one scan period
+  sensor_msgs::PointCloud2ConstIterator<float> point_time(cloud, "time");
+  EXPECT_FLOAT_EQ(0.0f, point_time[0]);
+  const double sweep = point_time[1] * cloud.width;
+  EXPECT_NEAR(kScanPeriod, sweep, 0.3 * kScanPeriod);
+
+  sensor_msgs::PointCloud2ConstIterator<float> x(cloud, "x");
+  sensor_msgs::PointCloud2ConstIterator<float> y(cloud, "y");
+  sensor_msgs::PointCloud2ConstIterator<uint16_t> ring(cloud, "ring");
+  float last_time = -1.0f;
+  for (unsigned int i = 0; i < cloud.width; ++i, ++x, ++y, ++ring, ++point_time)
+  {
+    EXPECT_GT(*point_time, last_time);
+    last_time = *point_time;
+    EXPECT_EQ(0u, *ring);
+
+    // column i is seen turned by the share of the sweep still ahead of it
+    const double yaw = kAngleMin + i * kAngleStep;
+    const double share = 1.0 - static_cast<double>(i) / cloud.width;
+    const double turn = atan2(*y, *x) - yaw;
+    EXPECT_NEAR(share * rate * sweep, turn, 0.02) << "column " << i;
+  }
+  EXPECT_NEAR((kRays - 1) * sweep / kRays, last_time, 1e-4);
+
+  cmd.angular.z = 0.0;
+  cmd_pub.publish(cmd);
+  cloud_sub_.shutdown();
+}
+
+int main(int argc, char** argv)
+{
+  ros::init(argc, argv, "gazebo_laser_test");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <gazebo_plugins/NoiseStream.h>
+
+#include <cmath>
+#include <vector>
+
+// the same seed and stream reproduce the same values
+TEST(NoiseStreamTest, deterministic)
+{
+  NoiseStream a(42, NoiseStream::hashName("world::model::link::sensor"));
+  NoiseStream b(42, NoiseStream::hashName("world::model::link::sensor"));
+  for (unsigned int i = 0; i < 1000; ++i)
+    EXPECT_EQ(a.gaussian(0.0, 1.0), b.gaussian(0.0, 1.0));
+
+  // restarting replays the stream
+  a.seed(42, 7);
+  double first = a.uniform();
+  a.uniform();
+  a.seed(42, 7);
+  EXPECT_EQ(first, a.uniform());
+}
+
+// stream ids of scoped names do not change between builds
+TEST(NoiseStreamTest, hashName)
+{
+  // FNV-1a reference values
+  EXPECT_EQ(0xCBF29CE484222325ull, NoiseStream::hashName(""));
+  EXPECT_EQ(0xAF63DC4C8601EC8Cull, NoiseStream::hashName("a"));
+  EXPECT_NE(NoiseStream::hashName("world::robot::sonar"),
+            NoiseStream::hashName("world::robot::sonar2"));
+}
+
+// different streams of the same seed are not correlated
+TEST(NoiseStreamTest, independentStreams)
+{
+  NoiseStream a(42, 0);
+  NoiseStream b(42, 1);
+  const unsigned int count = 100000;
+  double sum = 0.0;
+  for (unsigned int i = 0; i < count; ++i)
+    sum += a.gaussian(0.0, 1.0) * b.gaussian(0.0, 1.0);
+  EXPECT_NEAR(sum / count, 0.0, 0.02);
+}
+
+// single and batched samples have the requested moments
+TEST(NoiseStreamTest, moments)
+{
+  const size_t count = 200001;
+  const double mu = 1.5;
+  const double sigma = 0.25;
+
+  NoiseStream stream(3, 4);
+  std::vector<double> values(count, 0.0);
+  stream.gaussian(0.0, 1.0);  // leave a spare sample for addGaussian
+  stream.addGaussian(&values[0], count, sigma);
+
+  double sum = 0.0, sum2 = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double v = values[i] + mu;
+    sum += v;
+    sum2 += v * v;
+  }
+  double mean = sum / count;
+  EXPECT_NEAR(mean, mu, 0.005);
+  EXPECT_NEAR(std::sqrt(sum2 / count - mean * mean), sigma, 0.005);
+
+  sum = sum2 = 0.0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    double v = stream.gaussian(mu, sigma);
+    sum += v;
+    sum2 += v * v;
+  }
+  mean = sum / count;
+  EXPECT_NEAR(mean, mu, 0.005);
+  EXPECT_NEAR(std::sqrt(sum2 / count - mean * mean), sigma, 0.005);
+
+  // uniform values stay inside of (0, 1]
+  for (size_t i = 0; i < count; ++i)
+  {
+    double u = stream.uniform();
+    EXPECT_GT(u, 0.0);
+    EXPECT_LE(u, 1.0);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,125 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+/*
+ * Desc: Joint states of a model, read from physics once per world update
+ *       and shared by the plugins of the model.
+ */
+
+#ifndef GAZEBO_ROS_JOINT_STATE_CACHE_HH
+#define GAZEBO_ROS_JOINT_STATE_CACHE_HH
+
+#include <stdint.h>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <gazebo/physics/physics.hh>
+
+namespace gazebo
+{
+  class JointStateCache;
+  typedef boost::shared_ptr<JointStateCache> JointStateCachePtr;
+
+  /// \brief Position, velocity and effort of the joint axes used by the
+  /// plugins of a model, in one array each.
+  ///
+  /// All plugins of a model get the same cache through Get().  Each plugin
+  /// registers its joint axes at load and keeps the returned indices, then
+  /// calls Update() in its world update callback before reading.  The first
+  /// Update() of a world iteration reads the registered axes from physics,
+  /// the following ones return at once, so every plugin sees the state of
+  /// the joints at the beginning of the update, before any of them applied
+  /// commands.
+  ///
+  /// \verbatim
+  ///   // Load
+  ///   this->cache_ = JointStateCache::Get(_model);
+  ///   this->index_ = this->cache_->Register(_model->GetJoint("wheel"));
+  ///   // OnUpdate
+  ///   this->cache_->Update();
+  ///   double position = this->cache_->Position(this->index_);
+  /// \endverbatim
+  /// The cache is not locked, it is meant to be used from the physics
+  /// thread only.
+  class JointStateCache
+  {
+    /// \brief The cache of a model, created on the first call
+    /// \param[in] _model Model of the joints
+    /// \return Cache shared with the other plugins of the model
+    public: static JointStateCachePtr Get(physics::ModelPtr _model);
+
+    /// \brief Add an axis of a joint to the cache
+    /// \param[in] _joint Joint of the model, or of one of its nested models
+    /// \param[in] _axis Axis of the joint
+    /// \return Index of the axis in the arrays, the same for every plugin
+    /// registering the axis
+    public: unsigned int Register(physics::JointPtr _joint,
+                                  unsigned int _axis = 0);
+
+    /// \brief Read the registered axes from physics, once per world
+    /// iteration
+    public: void Update();
+
+    /// \brief Number of registered axes
+    public: unsigned int Size() const
+            { return this->positions_.size(); }
+
+    /// \brief Position of a registered axis, in radians or meters
+    public: double Position(unsigned int _index) const
+            { return this->positions_[_index]; }
+
+    /// \brief Velocity of a registered axis
+    public: double Velocity(unsigned int _index) const
+            { return this->velocities_[_index]; }
+
+    /// \brief Force or torque applied on a registered axis
+    public: double Effort(unsigned int _index) const
+            { return this->efforts_[_index]; }
+
+    /// \brief Positions of all registered axes
+    public: const std::vector<double> &Positions() const
+            { return this->positions_; }
+
+    /// \brief Velocities of all registered axes
+    public: const std::vector<double> &Velocities() const
+            { return this->velocities_; }
+
+    /// \brief Efforts of all registered axes
+    public: const std::vector<double> &Efforts() const
+            { return this->efforts_; }
+
+    /// \brief Constructor, use Get()
+    private: explicit JointStateCache(physics::WorldPtr _world);
+
+    private: physics::WorldPtr world_;
+
+    /// \brief Joint and axis of each index
+    private: std::vector<physics::JointPtr> joints_;
+    private: std::vector<unsigned int> axes_;
+
+    private: std::vector<double> positions_;
+    private: std::vector<double> velocities_;
+    private: std::vector<double> efforts_;
+
+    /// \brief World iteration of the arrays
+    private: uint64_t iteration_;
+
+    /// \brief False until the first update and after a registration
+    private: bool valid_;
+  };
+}
+#endif
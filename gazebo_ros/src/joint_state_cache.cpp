@@ -0,0 +1,117 @@
+/*
+ * Copyright 2026 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <map>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <gazebo_ros/joint_state_cache.h>
+
+namespace gazebo
+{
+namespace
+{
+// caches by model, plugins load from different threads
+boost::mutex g_caches_mutex;
+std::map<const physics::Model *, boost::weak_ptr<JointStateCache> > g_caches;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Constructor
+JointStateCache::JointStateCache(physics::WorldPtr _world)
+  : world_(_world), iteration_(0), valid_(false)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// The cache of a model
+JointStateCachePtr JointStateCache::Get(physics::ModelPtr _model)
+{
+  boost::mutex::scoped_lock lock(g_caches_mutex);
+
+  // a cache of a removed model may still be listed under the same address
+  JointStateCachePtr cache = g_caches[_model.get()].lock();
+  if (!cache)
+  {
+    cache.reset(new JointStateCache(_model->GetWorld()));
+    g_caches[_model.get()] = cache;
+  }
+
+  // forget the caches of removed models
+  for (std::map<const physics::Model *,
+       boost::weak_ptr<JointStateCache> >::iterator it = g_caches.begin();
+       it != g_caches.end();)
+  {
+    if (it->second.expired())
+      g_caches.erase(it++);
+    else
+      ++it;
+  }
+  return cache;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Add an axis of a joint
+unsigned int JointStateCache::Register(physics::JointPtr _joint,
+                                       unsigned int _axis)
+{
+  for (unsigned int i = 0; i < this->joints_.size(); ++i)
+  {
+    if (this->joints_[i] == _joint && this->axes_[i] == _axis)
+      return i;
+  }
+
+  this->joints_.push_back(_joint);
+  this->axes_.push_back(_axis);
+  this->positions_.push_back(0.0);
+  this->velocities_.push_back(0.0);
+  this->efforts_.push_back(0.0);
+  this->valid_ = false;
+  return this->joints_.size() - 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Read the registered axes once per world iteration
+void JointStateCache::Update()
+{
+#if GAZEBO_MAJOR_VERSION >= 8
+  const uint64_t iteration = this->world_->Iterations();
+#else
+  const uint64_t iteration = this->world_->GetIterations();
+#endif
+  if (this->valid_ && iteration == this->iteration_)
+    return;
+
+  const size_t n = this->joints_.size();
+  for (size_t i = 0; i < n; ++i)
+  {
+    const physics::JointPtr &joint = this->joints_[i];
+    const unsigned int axis = this->axes_[i];
+#if GAZEBO_MAJOR_VERSION >= 8
+    this->positions_[i] = joint->Position(axis);
+#else
+    this->positions_[i] = joint->GetAngle(axis).Radian();
+#endif
+    this->velocities_[i] = joint->GetVelocity(axis);
+    this->efforts_[i] = joint->GetForce(axis);
+  }
+
+  this->iteration_ = iteration;
+  this->valid_ = true;
+}
+}
@@ -0,0 +1,131 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   World level host of the controllers of many robots, with one robot simulation interface
+           loader and one world update connection for all of them.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___CONTROL_HOST_H_
+#define _GAZEBO_ROS_CONTROL___CONTROL_HOST_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <ros/ros.h>
+#include <pluginlib/class_loader.h>
+
+#include <gazebo/gazebo.hh>
+#include <gazebo/physics/physics.hh>
+
+#include <gazebo_ros_control/robot_hw_sim.h>
+#include <gazebo_ros_control/worker_pool.h>
+
+namespace gazebo_ros_control
+{
+
+class ControlHost;
+typedef boost::shared_ptr<ControlHost> ControlHostPtr;
+
+// Robot whose controllers are updated by a ControlHost
+class HostedRobot
+{
+public:
+  virtual ~HostedRobot() {}
+
+  // Update the robot simulation with the state of the gazebo model, return true if controllers
+  // are due in this step. Called on the world update thread.
+  virtual bool readRobot(const ros::Time& time) = 0;
+
+  // Update the controllers due in this step. Called on any thread of the host, at the same time
+  // as the controllers of other robots.
+  virtual void updateRobot(const ros::Time& time) = 0;
+
+  // Apply the commands of the controllers to the gazebo model. Called on the world update thread.
+  virtual void writeRobot(const ros::Time& time) = 0;
+};
+
+// Hosts the controllers of all robots of a world that are loaded with <controlHost>. The robot
+// simulation interfaces of all robots come from a single class loader, so each type is loaded once.
+// A single world update connection reads all robots, updates the controllers of the due ones in
+// parallel on a worker pool and writes all robots. Reading and writing stay on the world update
+// thread since they access the gazebo models.
+class ControlHost
+{
+public:
+  // The host of the world, created on the first call
+  static ControlHostPtr get(const gazebo::physics::WorldPtr& world);
+
+  ~ControlHost();
+
+  // Threads updating the controllers, including the world update thread
+  void setThreads(const unsigned int threads);
+
+  // Create a robot simulation interface of the given type
+  boost::shared_ptr<RobotHWSim> createRobotHWSim(const std::string& type);
+
+  // Update the controllers of the robot each step, until it is removed
+  void addRobot(HostedRobot* robot);
+  void removeRobot(HostedRobot* robot);
+
+private:
+  explicit ControlHost(const gazebo::physics::WorldPtr& world);
+
+  // Called by the world update start event
+  void update();
+
+  // Update the controllers of due_robots_[begin, end)
+  void updateRobots(const ros::Time& time, const std::size_t begin, const std::size_t end);
+
+  gazebo::physics::WorldPtr world_;
+  gazebo::event::ConnectionPtr update_connection_;
+
+  // Interface loader, shared by all robots
+  boost::mutex loader_mutex_;
+  boost::shared_ptr<pluginlib::ClassLoader<RobotHWSim> > robot_hw_sim_loader_;
+
+  // Robots and threads, locked by the world update
+  boost::mutex mutex_;
+  std::vector<HostedRobot*> robots_;
+  std::vector<HostedRobot*> due_robots_;
+  WorkerPoolPtr pool_;
+};
+
+}
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___CONTROL_HOST_H_
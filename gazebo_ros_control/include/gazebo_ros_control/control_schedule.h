@@ -0,0 +1,125 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Rate-monotonic schedule of the partitions of a gazebo_ros_control robot, which of them
+           are updated in a simulation step.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___CONTROL_SCHEDULE_H_
+#define _GAZEBO_ROS_CONTROL___CONTROL_SCHEDULE_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <ros/time.h>
+
+namespace gazebo_ros_control
+{
+
+// Partitions with a control period each, sorted by period with the fastest first. A partition is
+// due in the steps where its period elapsed since its last update, so the slow partitions are only
+// updated at their own rate.
+class ControlSchedule
+{
+public:
+  // Add a partition updated every period and return its position in the schedule. Partitions of
+  // the same period keep the order they were added in.
+  std::size_t add(const ros::Duration& period)
+  {
+    std::size_t i = entries_.size();
+    while (i > 0 && period < entries_[i - 1].period_)
+      --i;
+    Entry entry;
+    entry.period_ = period;
+    entries_.insert(entries_.begin() + i, entry);
+    return i;
+  }
+
+  // Number of partitions.
+  std::size_t size() const
+  {
+    return entries_.size();
+  }
+
+  // Control period of the partition at position i.
+  const ros::Duration& period(const std::size_t i) const
+  {
+    return entries_[i].period_;
+  }
+
+  // Time since the previous update of the partition at position i, set when it was last due.
+  const ros::Duration& updatePeriod(const std::size_t i) const
+  {
+    return entries_[i].update_period_;
+  }
+
+  // Positions of the partitions due at time, fastest first. Their update time is set to time.
+  void due(const ros::Time& time, std::vector<std::size_t>& due)
+  {
+    due.clear();
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+    {
+      Entry& entry = entries_[i];
+      const ros::Duration sim_period = time - entry.last_update_;
+      if (sim_period >= entry.period_)
+      {
+        entry.last_update_ = time;
+        entry.update_period_ = sim_period;
+        due.push_back(i);
+      }
+    }
+  }
+
+  // Forget the update times, after a world reset.
+  void reset()
+  {
+    for (std::size_t i = 0; i < entries_.size(); ++i)
+      entries_[i].last_update_ = ros::Time();
+  }
+
+private:
+  struct Entry
+  {
+    ros::Duration period_;
+    ros::Time last_update_;
+    ros::Duration update_period_;
+  };
+
+  std::vector<Entry> entries_;
+};
+
+}
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___CONTROL_SCHEDULE_H_
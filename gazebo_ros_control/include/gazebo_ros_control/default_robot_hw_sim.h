@@ -41,6 +41,9 @@
 #ifndef _GAZEBO_ROS_CONTROL___DEFAULT_ROBOT_HW_SIM_H_
 #define _GAZEBO_ROS_CONTROL___DEFAULT_ROBOT_HW_SIM_H_
 
+// Boost
+#include <boost/atomic.hpp>
+
 // ros_control
 #include <control_toolbox/pid.h>
 #include <hardware_interface/joint_command_interface.h>
@@ -58,16 +61,26 @@
 // ROS
 #include <ros/ros.h>
 #include <angles/angles.h>
+#include <dynamic_reconfigure/Config.h>
 #include <pluginlib/class_list_macros.h>
 
 // gazebo_ros_control
+#include <gazebo_ros_control/pid_bank.h>
 #include <gazebo_ros_control/robot_hw_sim.h>
+#include <gazebo_ros_control/worker_pool.h>
 
 // URDF
 #include <urdf/model.h>
 
 
 
+// Joint states shared with the other plugins of the model, defined in <gazebo_ros/joint_state_cache.h>
+namespace gazebo
+{
+class JointStateCache;
+typedef boost::shared_ptr<JointStateCache> JointStateCachePtr;
+}
+
 namespace gazebo_ros_control
 {
 
@@ -103,6 +116,17 @@ protected:
                            int *const joint_type, double *const lower_limit,
                            double *const upper_limit, double *const effort_limit);
 
+  // Split the joints by control method, so that writeSim() runs one loop without a switch per
+  // method, and take the worker threads of the PID joints if requested under model_nh. The
+  // threads are shared with the other robot simulations of parent_model.
+  void groupJoints(const ros::NodeHandle& model_nh, const gazebo::physics::ModelPtr& parent_model);
+
+  // Called when the gains of a PID joint were changed through dynamic reconfigure.
+  void pidGainsCB(const dynamic_reconfigure::ConfigConstPtr& config);
+
+  // Compute the efforts of the PID joints pid_joints_[begin, end) from pid_errors_.
+  void computePidEfforts(std::size_t begin, std::size_t end, const ros::Duration& period);
+
   unsigned int n_dof_;
 
   hardware_interface::JointStateInterface    js_interface_;
@@ -134,8 +158,43 @@ protected:
 
   std::vector<gazebo::physics::JointPtr> sim_joints_;
 
+  // Joint states read once per world update for all plugins of the model, and
+  // the cache index of each joint.
+  gazebo::JointStateCachePtr joint_state_cache_;
+  std::vector<unsigned int> joint_state_indices_;
+
   std::string physics_type_;
 
+  // Joints of each control method that is not PID controlled.
+  std::vector<unsigned int> effort_joints_;
+  std::vector<unsigned int> position_joints_;
+  std::vector<unsigned int> velocity_joints_;
+
+  // PID controlled joints, the POSITION_PID ones first, with their error, effort and effort
+  // limit at the same index. The revolute and continuous POSITION_PID joints wrap their error,
+  // they are listed by index in pid_joints_.
+  std::vector<unsigned int> pid_joints_;
+  std::size_t n_position_pid_;
+  std::vector<std::size_t> pid_revolute_;
+  std::vector<std::size_t> pid_continuous_;
+  std::vector<double> pid_errors_;
+  std::vector<double> pid_efforts_;
+  std::vector<double> pid_effort_limits_;
+
+  // Velocity commands go through SetVelocity() instead of SetParam("vel").
+  bool set_velocity_;
+
+  // With use_pid_bank_ the PID joints are computed by pid_bank_, which copies the gains of
+  // pid_controllers_ at load and in the next writeSim() after they were reconfigured.
+  bool use_pid_bank_;
+  PidBank pid_bank_;
+  std::vector<ros::Subscriber> pid_gains_subs_;
+  boost::atomic<bool> pid_gains_changed_;
+
+  // Threads computing the PID efforts, shared by model, NULL to compute them in writeSim() only.
+  WorkerPoolPtr worker_pool_;
+  int pid_chunk_size_;
+
   // e_stop_active_ is true if the emergency stop is active.
   bool e_stop_active_, last_e_stop_active_;
 };
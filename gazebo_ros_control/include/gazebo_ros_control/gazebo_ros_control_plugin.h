@@ -40,6 +40,7 @@
 */
 
 // Boost
+#include <boost/atomic.hpp>
 #include <boost/shared_ptr.hpp>
 #include <boost/thread.hpp>
 
@@ -54,6 +55,9 @@
 #include <gazebo/common/common.hh>
 
 // ros_control
+#include <gazebo_ros_control/control_host.h>
+#include <gazebo_ros_control/control_schedule.h>
+#include <gazebo_ros_control/robot_description.h>
 #include <gazebo_ros_control/robot_hw_sim.h>
 #include <controller_manager/controller_manager.h>
 #include <transmission_interface/transmission_parser.h>
@@ -61,10 +65,12 @@
 namespace gazebo_ros_control
 {
 
-class GazeboRosControlPlugin : public gazebo::ModelPlugin
+class GazeboRosControlPlugin : public gazebo::ModelPlugin, public HostedRobot
 {
 public:
 
+  GazeboRosControlPlugin();
+
   virtual ~GazeboRosControlPlugin();
 
   // Overloaded Gazebo entry point
@@ -82,9 +88,52 @@ public:
   // Get Transmissions from the URDF
   bool parseTransmissionsFromURDF(const std::string& urdf_string);
 
+  // Update the robot simulations of the due partitions with the state of the gazebo model, return
+  // true if controllers are due in this step
+  virtual bool readRobot(const ros::Time& time);
+
+  // Update the controllers of the partitions due in this step
+  virtual void updateRobot(const ros::Time& time);
+
+  // Apply the commands of all partitions to the gazebo model
+  virtual void writeRobot(const ros::Time& time);
+
 protected:
+  // A robot simulation interface and its controller manager, updated with a period of their own
+  struct ControlPartition
+  {
+    std::string name_;
+    std::string robot_hw_sim_type_;
+    ros::Duration control_period_;
+    std::vector<transmission_interface::TransmissionInfo> transmissions_;
+    boost::shared_ptr<gazebo_ros_control::RobotHWSim> robot_hw_sim_;
+    boost::shared_ptr<controller_manager::ControllerManager> controller_manager_;
+
+    // Timing, the update times are kept by the schedule
+    ros::Time last_write_sim_time_ros_;
+
+    // Reset the controllers on the next update, after the emergency stop is released
+    bool reset_controllers_;
+  };
+  typedef boost::shared_ptr<ControlPartition> ControlPartitionPtr;
+
   void eStopCB(const std_msgs::BoolConstPtr& e_stop_active);
 
+  // Split the transmissions into the <partition> elements of the plugin, or a single partition
+  bool loadPartitions(const ros::Duration& gazebo_period);
+
+  // Whether the controllers are reset, after the emergency stop is released
+  bool resetControllers();
+
+  // Hand the controller updates over to the control thread
+  void startControl(const ros::Time& time);
+
+  // Wait until the control thread finished its step, return false if it was still running
+  bool waitForControl();
+
+  // Update the controllers handed over by the physics step
+  void controlThread();
+
   // Node Handles
   ros::NodeHandle model_nh_; // namespaces to robot name
 
@@ -100,12 +149,18 @@ protected:
 
   // Interface loader
   boost::shared_ptr<pluginlib::ClassLoader<gazebo_ros_control::RobotHWSim> > robot_hw_sim_loader_;
+
+  // World level host updating the controllers instead of Update(), which also loads the interfaces
+  ControlHostPtr control_host_;
   void load_robot_hw_sim_srv();
 
   // Strings
   std::string robot_namespace_;
   std::string robot_description_;
 
+  // Parsed robot description, shared with the robots of the same URDF
+  RobotDescriptionConstPtr description_;
+
   // Transmissions in this plugin's scope
   std::vector<transmission_interface::TransmissionInfo> transmissions_;
 
@@ -116,15 +171,44 @@ protected:
   // Controller manager
   boost::shared_ptr<controller_manager::ControllerManager> controller_manager_;
 
-  // Timing
+  // Timing, control_period_ is the default of the partitions. The last update and write times
+  // are the ones of the first partition.
   ros::Duration control_period_;
   ros::Time last_update_sim_time_ros_;
   ros::Time last_write_sim_time_ros_;
 
+  // Partitions sorted by control period, the fastest first, in the order of schedule_.
+  // robot_hw_sim_ and controller_manager_ are the ones of the first partition.
+  std::vector<ControlPartitionPtr> partitions_;
+  ControlSchedule schedule_;
+
+  // Positions of the partitions whose controllers are updated in the current step
+  std::vector<std::size_t> due_partitions_;
+
   // e_stop_active_ is true if the emergency stop is active.
   bool e_stop_active_, last_e_stop_active_;
   ros::Subscriber e_stop_sub_;  // Emergency stop subscriber
 
+  // Optional control thread. The physics step and the control thread hand the robot simulation
+  // interface over to each other with the step counters, readSim() and writeSim() stay in the
+  // physics step since they read and write the gazebo model. With control_delay_ the controllers
+  // run along the next physics step and their commands are applied one step later.
+  boost::thread control_thread_;
+  bool control_delay_;
+  int control_cpu_;
+  int control_priority_;
+  boost::atomic<unsigned long> control_requested_;
+  boost::atomic<unsigned long> control_completed_;
+  boost::atomic<bool> control_stop_;
+  boost::mutex control_mutex_;
+  boost::condition_variable control_cond_;
+
+  // Step handed over to the control thread, along with due_partitions_
+  ros::Time control_time_;
+
+  // Steps where the physics waited for the control thread
+  unsigned long control_overruns_;
+
 };
 
 
@@ -0,0 +1,109 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   PID controllers of many joints updated in one pass over arrays.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___PID_BANK_H_
+#define _GAZEBO_ROS_CONTROL___PID_BANK_H_
+
+#include <cstddef>
+#include <vector>
+
+#include <boost/align/aligned_allocator.hpp>
+#include <control_toolbox/pid.h>
+
+namespace gazebo_ros_control
+{
+
+// The PID controllers of a set of joints, with the gains, limits and state of all controllers in
+// one array each. computeCommands() updates a range of them in a loop without branches that the
+// compiler vectorizes, instead of one control_toolbox::Pid::computeCommand() call per joint. The
+// result is the one of Pid::computeCommand(error, dt) for a positive dt.
+//
+// The bank does not read parameters itself, the gains are copied from control_toolbox::Pid
+// objects initialized from the usual ROS parameters.
+class PidBank
+{
+public:
+  // Add a controller with the gains of pid and a zero state, return its index.
+  std::size_t add(const control_toolbox::Pid::Gains& gains);
+
+  // Replace the gains of controller i, keeping its state.
+  void setGains(const std::size_t i, const control_toolbox::Pid::Gains& gains);
+
+  // Zero the state of all controllers.
+  void reset();
+
+  std::size_t size() const
+  {
+    return p_gain_.size();
+  }
+
+  // Compute commands[i] from errors[i] for the controllers [begin, end), dt seconds after the
+  // previous call. Like Pid, a controller given a NaN or infinite error commands 0 and keeps its
+  // state, and all of them do so for a zero dt. A negative dt, which Pid integrates backwards
+  // with its previous derivative, is treated like a zero one.
+  void computeCommands(const std::size_t begin, const std::size_t end,
+                       const double* errors, double* commands, const double dt);
+
+private:
+  // Update the controllers [begin, end) whose errors are all finite.
+  void update(const std::size_t begin, const std::size_t end,
+              const double* errors, double* commands, const double dt);
+
+  typedef std::vector<double, boost::alignment::aligned_allocator<double, 64> > Array;
+
+
+  Array p_gain_;
+  Array i_gain_;
+  Array d_gain_;
+  Array i_min_;
+  Array i_max_;
+
+  // Bounds of the integrated error with anti windup, infinite without.
+  Array i_error_min_;
+  Array i_error_max_;
+
+  // 1 with anti windup, 0 without.
+  Array antiwindup_;
+
+  Array i_error_;
+  Array p_error_last_;
+};
+
+}
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___PID_BANK_H_
@@ -0,0 +1,92 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Robot descriptions parsed once per process, shared by the robots of the same type.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___ROBOT_DESCRIPTION_H_
+#define _GAZEBO_ROS_CONTROL___ROBOT_DESCRIPTION_H_
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <transmission_interface/transmission_info.h>
+#include <urdf/model.h>
+
+namespace gazebo_ros_control
+{
+
+class RobotDescription;
+typedef boost::shared_ptr<const RobotDescription> RobotDescriptionConstPtr;
+
+// The URDF model and the transmissions of a robot description. Descriptions are looked up by the
+// hash of their URDF, so robots loaded from the same URDF share a single parse of it as long as
+// one of them holds the description.
+class RobotDescription
+{
+public:
+  // The parsed description of urdf_string, parsed on the first call with its content
+  static RobotDescriptionConstPtr get(const std::string& urdf_string);
+
+  const std::string& urdf() const
+  {
+    return urdf_;
+  }
+
+  // The URDF model, NULL if the URDF does not parse
+  const urdf::Model* model() const
+  {
+    return model_valid_ ? &model_ : NULL;
+  }
+
+  const std::vector<transmission_interface::TransmissionInfo>& transmissions() const
+  {
+    return transmissions_;
+  }
+
+private:
+  explicit RobotDescription(const std::string& urdf_string);
+
+  std::string urdf_;
+  urdf::Model model_;
+  bool model_valid_;
+  std::vector<transmission_interface::TransmissionInfo> transmissions_;
+};
+
+}
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___ROBOT_DESCRIPTION_H_
@@ -0,0 +1,173 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Fixed set of threads running chunks of a loop, for the per step work
+           of gazebo_ros_control that is independent between items.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___WORKER_POOL_H_
+#define _GAZEBO_ROS_CONTROL___WORKER_POOL_H_
+
+#include <algorithm>
+#include <cstddef>
+
+#include <boost/atomic.hpp>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace gazebo_ros_control
+{
+
+// Runs a loop over [0, n) in chunks on threads - 1 workers and the calling thread. The workers
+// are started once and sleep between runs, so a run only costs a wake up, which makes it usable
+// once per simulation step.
+class WorkerPool
+{
+public:
+  // Function running the items [begin, end) of a loop.
+  typedef boost::function<void(std::size_t begin, std::size_t end)> Task;
+
+  explicit WorkerPool(const unsigned int threads) :
+    stop_(false), generation_(0), n_(0), chunk_(1), next_(0), busy_(0)
+  {
+    for (unsigned int i = 1; i < threads; ++i)
+      workers_.create_thread(boost::bind(&WorkerPool::work, this));
+  }
+
+  ~WorkerPool()
+  {
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      stop_ = true;
+    }
+    start_cond_.notify_all();
+    workers_.join_all();
+  }
+
+  // Number of threads running a loop, including the calling one.
+  unsigned int size() const
+  {
+    return workers_.size() + 1;
+  }
+
+  // Run task over [0, n) in chunks of at most chunk items and return once all of them ran. A loop
+  // of one chunk runs on the calling thread only.
+  void run(const std::size_t n, const std::size_t chunk, const Task& task)
+  {
+    if (n == 0)
+      return;
+    if (workers_.size() == 0 || n <= chunk)
+    {
+      task(0, n);
+      return;
+    }
+
+    {
+      boost::mutex::scoped_lock lock(mutex_);
+      task_ = task;
+      n_ = n;
+      chunk_ = std::max<std::size_t>(chunk, 1);
+      next_ = 0;
+      busy_ = workers_.size();
+      ++generation_;
+    }
+    start_cond_.notify_all();
+
+    runChunks();
+
+    boost::mutex::scoped_lock lock(mutex_);
+    while (busy_ > 0)
+      done_cond_.wait(lock);
+  }
+
+private:
+  // Take chunks until the loop is done.
+  void runChunks()
+  {
+    for (;;)
+    {
+      const std::size_t begin = next_.fetch_add(chunk_);
+      if (begin >= n_)
+        break;
+      task_(begin, std::min(begin + chunk_, n_));
+    }
+  }
+
+  void work()
+  {
+    std::size_t done_generation = 0;
+    boost::mutex::scoped_lock lock(mutex_);
+    for (;;)
+    {
+      while (!stop_ && generation_ == done_generation)
+        start_cond_.wait(lock);
+      if (stop_)
+        return;
+      done_generation = generation_;
+
+      lock.unlock();
+      runChunks();
+      lock.lock();
+
+      if (--busy_ == 0)
+        done_cond_.notify_one();
+    }
+  }
+
+  boost::thread_group workers_;
+  boost::mutex mutex_;
+  boost::condition_variable start_cond_;
+  boost::condition_variable done_cond_;
+  bool stop_;
+
+  // Count of runs, a worker joins each run once.
+  std::size_t generation_;
+
+  // The current run, written before the workers are woken up.
+  Task task_;
+  std::size_t n_;
+  std::size_t chunk_;
+  boost::atomic<std::size_t> next_;
+
+  // Workers still running the current run.
+  unsigned int busy_;
+};
+
+typedef boost::shared_ptr<WorkerPool> WorkerPoolPtr;
+
+}
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___WORKER_POOL_H_
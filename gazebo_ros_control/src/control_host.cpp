@@ -0,0 +1,170 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   World level host of the controllers of many robots, with one robot simulation interface
+           loader and one world update connection for all of them.
+*/
+
+#include <algorithm>
+#include <map>
+
+#include <boost/bind.hpp>
+
+#include <gazebo_ros_control/control_host.h>
+
+namespace gazebo_ros_control
+{
+
+namespace
+{
+// Hosts by world, robots load from different threads
+boost::mutex g_hosts_mutex;
+std::map<const gazebo::physics::World*, boost::weak_ptr<ControlHost> > g_hosts;
+}
+
+ControlHost::ControlHost(const gazebo::physics::WorldPtr& world) :
+  world_(world)
+{
+  robot_hw_sim_loader_.reset
+    (new pluginlib::ClassLoader<RobotHWSim>
+      ("gazebo_ros_control",
+        "gazebo_ros_control::RobotHWSim"));
+
+  // Listen to the update event. This event is broadcast every simulation iteration.
+  update_connection_ =
+    gazebo::event::Events::ConnectWorldUpdateBegin
+    (boost::bind(&ControlHost::update, this));
+}
+
+ControlHost::~ControlHost()
+{
+  // Disconnect from gazebo events
+  update_connection_.reset();
+}
+
+// The host of the world, created on the first call
+ControlHostPtr ControlHost::get(const gazebo::physics::WorldPtr& world)
+{
+  boost::mutex::scoped_lock lock(g_hosts_mutex);
+
+  // A host of a removed world may still be listed under the same address
+  ControlHostPtr host = g_hosts[world.get()].lock();
+  if (!host)
+  {
+    host.reset(new ControlHost(world));
+    g_hosts[world.get()] = host;
+  }
+
+  // Forget the hosts of removed worlds
+  for (std::map<const gazebo::physics::World*, boost::weak_ptr<ControlHost> >::iterator it = g_hosts.begin();
+       it != g_hosts.end();)
+  {
+    if (it->second.expired())
+      g_hosts.erase(it++);
+    else
+      ++it;
+  }
+  return host;
+}
+
+// Threads updating the controllers, including the world update thread
+void ControlHost::setThreads(const unsigned int threads)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  if (pool_ && pool_->size() == std::max(threads, 1u))
+    return;
+  pool_.reset(new WorkerPool(threads));
+}
+
+// Create a robot simulation interface of the given type
+boost::shared_ptr<RobotHWSim> ControlHost::createRobotHWSim(const std::string& type)
+{
+  boost::mutex::scoped_lock lock(loader_mutex_);
+  return robot_hw_sim_loader_->createInstance(type);
+}
+
+// Update the controllers of the robot each step, until it is removed
+void ControlHost::addRobot(HostedRobot* robot)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  robots_.push_back(robot);
+  due_robots_.reserve(robots_.size());
+}
+
+void ControlHost::removeRobot(HostedRobot* robot)
+{
+  boost::mutex::scoped_lock lock(mutex_);
+  robots_.erase(std::remove(robots_.begin(), robots_.end(), robot), robots_.end());
+}
+
+// Called by the world update start event
+void ControlHost::update()
+{
+  // Get the simulation time
+#if GAZEBO_MAJOR_VERSION >= 8
+  gazebo::common::Time gz_time_now = world_->SimTime();
+#else
+  gazebo::common::Time gz_time_now = world_->GetSimTime();
+#endif
+  const ros::Time sim_time_ros(gz_time_now.sec, gz_time_now.nsec);
+
+  boost::mutex::scoped_lock lock(mutex_);
+
+  // Update the robot simulations with the state of the gazebo models
+  due_robots_.clear();
+  for (std::size_t i = 0; i < robots_.size(); ++i)
+  {
+    if (robots_[i]->readRobot(sim_time_ros))
+      due_robots_.push_back(robots_[i]);
+  }
+
+  // Compute the controller commands, one robot per chunk
+  if (!pool_)
+    pool_.reset(new WorkerPool(1));
+  pool_->run(due_robots_.size(), 1, boost::bind(&ControlHost::updateRobots, this, sim_time_ros, _1, _2));
+
+  // Update the gazebo models with the result of the controller computation
+  for (std::size_t i = 0; i < robots_.size(); ++i)
+    robots_[i]->writeRobot(sim_time_ros);
+}
+
+// Update the controllers of due_robots_[begin, end)
+void ControlHost::updateRobots(const ros::Time& time, const std::size_t begin, const std::size_t end)
+{
+  for (std::size_t i = begin; i < end; ++i)
+    due_robots_[i]->updateRobot(time);
+}
+
+} // namespace
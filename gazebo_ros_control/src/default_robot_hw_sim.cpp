@@ -40,12 +40,46 @@
 
 
 #include <gazebo_ros_control/default_robot_hw_sim.h>
+#include <gazebo_ros/joint_state_cache.h>
 #include <urdf/model.h>
 
+#include <map>
+
 
 namespace
 {
 
+// Worker pools by model, so the robot simulations of the partitions of one model share their
+// threads. Robots load from different threads.
+typedef std::map<const gazebo::physics::Model *,
+                 boost::weak_ptr<gazebo_ros_control::WorkerPool> > WorkerPoolMap;
+boost::mutex g_worker_pools_mutex;
+WorkerPoolMap g_worker_pools;
+
+gazebo_ros_control::WorkerPoolPtr getWorkerPool(const gazebo::physics::ModelPtr& model,
+                                                const unsigned int threads)
+{
+  boost::mutex::scoped_lock lock(g_worker_pools_mutex);
+
+  // a pool of a removed model may still be listed under the same address
+  gazebo_ros_control::WorkerPoolPtr pool = g_worker_pools[model.get()].lock();
+  if (!pool)
+  {
+    pool.reset(new gazebo_ros_control::WorkerPool(threads));
+    g_worker_pools[model.get()] = pool;
+  }
+
+  // forget the pools of removed models
+  for (WorkerPoolMap::iterator it = g_worker_pools.begin(); it != g_worker_pools.end();)
+  {
+    if (it->second.expired())
+      g_worker_pools.erase(it++);
+    else
+      ++it;
+  }
+  return pool;
+}
+
 double clamp(const double val, const double min_val, const double max_val)
 {
   return std::min(std::max(val, min_val), max_val);
@@ -68,6 +102,9 @@ bool DefaultRobotHWSim::initSim(
   // parameter's name is "joint_limits/<joint name>". An example is "joint_limits/axle_joint".
   const ros::NodeHandle joint_limit_nh(model_nh);
 
+  // Joint states shared with the other plugins of the model
+  joint_state_cache_ = gazebo::JointStateCache::Get(parent_model);
+
   // Resize vectors to our DOF
   n_dof_ = transmissions.size();
   joint_names_.resize(n_dof_);
@@ -196,6 +233,7 @@ bool DefaultRobotHWSim::initSim(
       return false;
     }
     sim_joints_.push_back(joint);
+    joint_state_indices_.push_back(joint_state_cache_->Register(joint));
 
     // get physics engine type
 #if GAZEBO_MAJOR_VERSION >= 8
@@ -255,19 +293,100 @@ bool DefaultRobotHWSim::initSim(
   e_stop_active_ = false;
   last_e_stop_active_ = false;
 
+  groupJoints(model_nh, parent_model);
+
   return true;
 }
 
-void DefaultRobotHWSim::readSim(ros::Time time, ros::Duration period)
+void DefaultRobotHWSim::groupJoints(const ros::NodeHandle& model_nh,
+                                    const gazebo::physics::ModelPtr& parent_model)
 {
-  for(unsigned int j=0; j < n_dof_; j++)
+  // sim_joints_ only holds the joints of the valid transmissions
+  const unsigned int n_joints = std::min<std::size_t>(n_dof_, sim_joints_.size());
+
+  std::vector<unsigned int> velocity_pid_joints;
+  for (unsigned int j = 0; j < n_joints; j++)
   {
-    // Gazebo has an interesting API...
-#if GAZEBO_MAJOR_VERSION >= 8
-    double position = sim_joints_[j]->Position(0);
+    switch (joint_control_methods_[j])
+    {
+      case EFFORT:
+        effort_joints_.push_back(j);
+        break;
+      case POSITION:
+        position_joints_.push_back(j);
+        break;
+      case POSITION_PID:
+        if (joint_types_[j] == urdf::Joint::REVOLUTE)
+          pid_revolute_.push_back(pid_joints_.size());
+        else if (joint_types_[j] == urdf::Joint::CONTINUOUS)
+          pid_continuous_.push_back(pid_joints_.size());
+        pid_joints_.push_back(j);
+        break;
+      case VELOCITY:
+        velocity_joints_.push_back(j);
+        break;
+      case VELOCITY_PID:
+        velocity_pid_joints.push_back(j);
+        break;
+    }
+  }
+  n_position_pid_ = pid_joints_.size();
+  pid_joints_.insert(pid_joints_.end(), velocity_pid_joints.begin(), velocity_pid_joints.end());
+
+  pid_errors_.resize(pid_joints_.size());
+  pid_efforts_.resize(pid_joints_.size());
+  pid_effort_limits_.resize(pid_joints_.size());
+  for (std::size_t i = 0; i < pid_joints_.size(); i++)
+    pid_effort_limits_[i] = joint_effort_limits_[pid_joints_[i]];
+
+  model_nh.param("gazebo_ros_control/pid_bank", use_pid_bank_, false);
+  if (use_pid_bank_)
+  {
+    for (std::size_t i = 0; i < pid_joints_.size(); i++)
+      pid_bank_.add(pid_controllers_[pid_joints_[i]].getGains());
+
+    // The gain servers of the controllers publish their updates after the gains changed
+    pid_gains_changed_ = false;
+    for (std::size_t i = 0; i < pid_joints_.size(); i++)
+    {
+      ros::NodeHandle nh(model_nh, "gazebo_ros_control/pid_gains/" + joint_names_[pid_joints_[i]]);
+      pid_gains_subs_.push_back(nh.subscribe("parameter_updates", 1,
+                                             &DefaultRobotHWSim::pidGainsCB, this));
+    }
+    ROS_INFO_STREAM_NAMED("default_robot_hw_sim", "Computing the efforts of " << pid_joints_.size()
+      << " PID joints in one pass.");
+  }
+
+#if GAZEBO_MAJOR_VERSION > 2
+  set_velocity_ = physics_type_.compare("dart") == 0;
 #else
-    double position = sim_joints_[j]->GetAngle(0).Radian();
+  set_velocity_ = true;
 #endif
+
+  // Every PID joint only touches its own controller, so their efforts may be computed in
+  // parallel. Gazebo joints are written from the physics thread only. The partitions of a model
+  // are written one after the other, so they share one pool.
+  int threads = 1;
+  model_nh.param("gazebo_ros_control/threads", threads, 1);
+  model_nh.param("gazebo_ros_control/pid_chunk_size", pid_chunk_size_, 32);
+  if (pid_chunk_size_ < 1)
+    pid_chunk_size_ = 1;
+  if (threads > 1 && pid_joints_.size() > static_cast<std::size_t>(pid_chunk_size_))
+  {
+    worker_pool_ = getWorkerPool(parent_model, threads);
+    ROS_INFO_STREAM_NAMED("default_robot_hw_sim", "Computing the efforts of " << pid_joints_.size()
+      << " PID joints on " << worker_pool_->size() << " threads in chunks of " << pid_chunk_size_
+      << ".");
+  }
+}
+
+void DefaultRobotHWSim::readSim(ros::Time time, ros::Duration period)
+{
+  joint_state_cache_->Update();
+  for(unsigned int j=0; j < n_dof_; j++)
+  {
+    const unsigned int index = joint_state_indices_[j];
+    double position = joint_state_cache_->Position(index);
     if (joint_types_[j] == urdf::Joint::PRISMATIC)
     {
       joint_position_[j] = position;
@@ -277,8 +396,8 @@ void DefaultRobotHWSim::readSim(ros::Time time, ros::Duration period)
       joint_position_[j] += angles::shortest_angular_distance(joint_position_[j],
                             position);
     }
-    joint_velocity_[j] = sim_joints_[j]->GetVelocity(0);
-    joint_effort_[j] = sim_joints_[j]->GetForce((unsigned int)(0));
+    joint_velocity_[j] = joint_state_cache_->Velocity(index);
+    joint_effort_[j] = joint_state_cache_->Effort(index);
   }
 }
 
@@ -306,80 +425,108 @@ void DefaultRobotHWSim::writeSim(ros::Time time, ros::Duration period)
   vj_sat_interface_.enforceLimits(period);
   vj_limits_interface_.enforceLimits(period);
 
-  for(unsigned int j=0; j < n_dof_; j++)
+  for (std::size_t i = 0; i < effort_joints_.size(); i++)
   {
-    switch (joint_control_methods_[j])
-    {
-      case EFFORT:
-        {
-          const double effort = e_stop_active_ ? 0 : joint_effort_command_[j];
-          sim_joints_[j]->SetForce(0, effort);
-        }
-        break;
+    const unsigned int j = effort_joints_[i];
+    const double effort = e_stop_active_ ? 0 : joint_effort_command_[j];
+    sim_joints_[j]->SetForce(0, effort);
+  }
 
-      case POSITION:
+  for (std::size_t i = 0; i < position_joints_.size(); i++)
+  {
+    const unsigned int j = position_joints_[i];
 #if GAZEBO_MAJOR_VERSION >= 9
-        sim_joints_[j]->SetPosition(0, joint_position_command_[j], true);
+    sim_joints_[j]->SetPosition(0, joint_position_command_[j], true);
 #else
-        sim_joints_[j]->SetPosition(0, joint_position_command_[j]);
+    sim_joints_[j]->SetPosition(0, joint_position_command_[j]);
 #endif
-        break;
-
-      case POSITION_PID:
-        {
-          double error;
-          switch (joint_types_[j])
-          {
-            case urdf::Joint::REVOLUTE:
-              angles::shortest_angular_distance_with_limits(joint_position_[j],
-                                                            joint_position_command_[j],
-                                                            joint_lower_limits_[j],
-                                                            joint_upper_limits_[j],
-                                                            error);
-              break;
-            case urdf::Joint::CONTINUOUS:
-              error = angles::shortest_angular_distance(joint_position_[j],
-                                                        joint_position_command_[j]);
-              break;
-            default:
-              error = joint_position_command_[j] - joint_position_[j];
-          }
-
-          const double effort_limit = joint_effort_limits_[j];
-          const double effort = clamp(pid_controllers_[j].computeCommand(error, period),
-                                      -effort_limit, effort_limit);
-          sim_joints_[j]->SetForce(0, effort);
-        }
-        break;
+  }
 
-      case VELOCITY:
+  for (std::size_t i = 0; i < velocity_joints_.size(); i++)
+  {
+    const unsigned int j = velocity_joints_[i];
+    const double velocity = e_stop_active_ ? 0 : joint_velocity_command_[j];
 #if GAZEBO_MAJOR_VERSION > 2
-        if (physics_type_.compare("dart") == 0)
-        {
-          sim_joints_[j]->SetVelocity(0, e_stop_active_ ? 0 : joint_velocity_command_[j]);
-        }
-        else 
-        {
-          sim_joints_[j]->SetParam("vel", 0, e_stop_active_ ? 0 : joint_velocity_command_[j]);
-        }
+    if (set_velocity_)
+      sim_joints_[j]->SetVelocity(0, velocity);
+    else
+      sim_joints_[j]->SetParam("vel", 0, velocity);
 #else
-        sim_joints_[j]->SetVelocity(0, e_stop_active_ ? 0 : joint_velocity_command_[j]);
+    sim_joints_[j]->SetVelocity(0, velocity);
 #endif
-        break;
+  }
 
-      case VELOCITY_PID:
-        double error;
-        if (e_stop_active_)
-          error = -joint_velocity_[j];
-        else
-          error = joint_velocity_command_[j] - joint_velocity_[j];
-        const double effort_limit = joint_effort_limits_[j];
-        const double effort = clamp(pid_controllers_[j].computeCommand(error, period),
-                                    -effort_limit, effort_limit);
-        sim_joints_[j]->SetForce(0, effort);
-        break;
-    }
+  if (pid_joints_.empty())
+    return;
+
+  // Errors of the POSITION_PID joints, wrapped for revolute and continuous joints, then of the
+  // VELOCITY_PID joints.
+  const std::size_t n_pid = pid_joints_.size();
+  for (std::size_t i = 0; i < n_position_pid_; i++)
+  {
+    const unsigned int j = pid_joints_[i];
+    pid_errors_[i] = joint_position_command_[j] - joint_position_[j];
+  }
+  for (std::size_t k = 0; k < pid_revolute_.size(); k++)
+  {
+    const std::size_t i = pid_revolute_[k];
+    const unsigned int j = pid_joints_[i];
+    angles::shortest_angular_distance_with_limits(joint_position_[j],
+                                                  joint_position_command_[j],
+                                                  joint_lower_limits_[j],
+                                                  joint_upper_limits_[j],
+                                                  pid_errors_[i]);
+  }
+  for (std::size_t k = 0; k < pid_continuous_.size(); k++)
+  {
+    const std::size_t i = pid_continuous_[k];
+    const unsigned int j = pid_joints_[i];
+    pid_errors_[i] = angles::shortest_angular_distance(joint_position_[j],
+                                                       joint_position_command_[j]);
+  }
+  for (std::size_t i = n_position_pid_; i < n_pid; i++)
+  {
+    const unsigned int j = pid_joints_[i];
+    pid_errors_[i] = (e_stop_active_ ? 0 : joint_velocity_command_[j]) - joint_velocity_[j];
+  }
+
+  // Gains changed through dynamic reconfigure since the last step
+  if (use_pid_bank_ && pid_gains_changed_.exchange(false))
+  {
+    for (std::size_t i = 0; i < n_pid; i++)
+      pid_bank_.setGains(i, pid_controllers_[pid_joints_[i]].getGains());
+  }
+
+  if (worker_pool_)
+    worker_pool_->run(n_pid, pid_chunk_size_,
+                      boost::bind(&DefaultRobotHWSim::computePidEfforts, this, _1, _2, period));
+  else
+    computePidEfforts(0, n_pid, period);
+
+  // Branchless, vectorized by the compiler
+  for (std::size_t i = 0; i < n_pid; i++)
+    pid_efforts_[i] = clamp(pid_efforts_[i], -pid_effort_limits_[i], pid_effort_limits_[i]);
+
+  for (std::size_t i = 0; i < n_pid; i++)
+    sim_joints_[pid_joints_[i]]->SetForce(0, pid_efforts_[i]);
+}
+
+void DefaultRobotHWSim::pidGainsCB(const dynamic_reconfigure::ConfigConstPtr& config)
+{
+  pid_gains_changed_ = true;
+}
+
+void DefaultRobotHWSim::computePidEfforts(std::size_t begin, std::size_t end,
+                                          const ros::Duration& period)
+{
+  if (use_pid_bank_)
+  {
+    pid_bank_.computeCommands(begin, end, &pid_errors_[0], &pid_efforts_[0], period.toSec());
+    return;
   }
+
+  for (std::size_t i = begin; i < end; i++)
+    pid_efforts_[i] = pid_controllers_[pid_joints_[i]].computeCommand(pid_errors_[i], period);
 }
 
 void DefaultRobotHWSim::eStopActive(const bool active)
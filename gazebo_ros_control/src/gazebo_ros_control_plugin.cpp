@@ -44,16 +44,46 @@
 
 #include <gazebo_ros_control/gazebo_ros_control_plugin.h>
 #include <urdf/model.h>
-#include <chrono>
-#include <thread>
+#include <algorithm>
+#include <sstream>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 namespace gazebo_ros_control
 {
 
+GazeboRosControlPlugin::GazeboRosControlPlugin() :
+  control_delay_(false), control_cpu_(-1), control_priority_(0),
+  control_requested_(0), control_completed_(0), control_stop_(false), control_overruns_(0)
+{
+}
+
 GazeboRosControlPlugin::~GazeboRosControlPlugin()
 {
   // Disconnect from gazebo events
   update_connection_.reset();
+  if (control_host_)
+  {
+    control_host_->removeRobot(this);
+  }
+
+  // Stop the control thread after its last step
+  if (control_thread_.joinable())
+  {
+    waitForControl();
+    control_stop_ = true;
+    control_cond_.notify_one();
+    control_thread_.join();
+
+    if (control_overruns_ > 0)
+    {
+      ROS_WARN_STREAM_NAMED("gazebo_ros_control","The controllers of " << robot_namespace_ << " overran "
+        << control_overruns_ << " of " << control_requested_.load() << " simulation steps.");
+    }
+  }
 }
 
 // Overloaded Gazebo entry point
@@ -146,6 +176,43 @@ void GazeboRosControlPlugin::Load(gazebo::physics::ModelPtr parent, sdf::Element
       << control_period_);
   }
 
+  // Run the controllers on a thread of their own
+  bool control_thread = false;
+  if (sdf_->HasElement("controlThread"))
+  {
+    control_thread = sdf_->Get<bool>("controlThread");
+  }
+  if (sdf_->HasElement("controlDelay"))
+  {
+    control_delay_ = sdf_->Get<bool>("controlDelay");
+  }
+  if (sdf_->HasElement("controlThreadCpu"))
+  {
+    control_cpu_ = sdf_->Get<int>("controlThreadCpu");
+  }
+  if (sdf_->HasElement("controlThreadPriority"))
+  {
+    control_priority_ = sdf_->Get<int>("controlThreadPriority");
+  }
+  // Let the world level control host update the controllers
+  bool control_host = false;
+  if (sdf_->HasElement("controlHost"))
+  {
+    control_host = sdf_->Get<bool>("controlHost");
+  }
+  if (control_host && control_thread)
+  {
+    ROS_WARN_STREAM_NAMED("gazebo_ros_control","<controlThread> does not apply with <controlHost>, "
+      "the controllers are updated by the control host.");
+    control_thread = false;
+  }
+  if (control_delay_ && !control_thread)
+  {
+    ROS_WARN_STREAM_NAMED("gazebo_ros_control","<controlDelay> only applies with <controlThread>, "
+      "the controllers are updated in the physics step.");
+    control_delay_ = false;
+  }
+
   // Get parameters/settings for controllers from ROS param server
   model_nh_ = ros::NodeHandle(robot_namespace_);
 
@@ -170,33 +237,72 @@ void GazeboRosControlPlugin::Load(gazebo::physics::ModelPtr parent, sdf::Element
     return;
   }
 
+  // Split the transmissions into the partitions updated at their own rates
+  if (!loadPartitions(gazebo_period))
+  {
+    ROS_ERROR_NAMED("gazebo_ros_control", "Error in the partitions of the gazebo_ros_control plugin, plugin not active.");
+    return;
+  }
+
   // Load the RobotHWSim abstraction to interface the controllers with the gazebo model
   try
   {
-    robot_hw_sim_loader_.reset
-      (new pluginlib::ClassLoader<gazebo_ros_control::RobotHWSim>
-        ("gazebo_ros_control",
-          "gazebo_ros_control::RobotHWSim"));
+    if (control_host)
+    {
+      control_host_ = ControlHost::get(parent_model_->GetWorld());
+    }
+    else
+    {
+      robot_hw_sim_loader_.reset
+        (new pluginlib::ClassLoader<gazebo_ros_control::RobotHWSim>
+          ("gazebo_ros_control",
+            "gazebo_ros_control::RobotHWSim"));
+    }
 
-    robot_hw_sim_ = robot_hw_sim_loader_->createInstance(robot_hw_sim_type_str_);
-    urdf::Model urdf_model;
-    const urdf::Model *const urdf_model_ptr = urdf_model.initString(urdf_string) ? &urdf_model : NULL;
+    const urdf::Model *const urdf_model_ptr = description_->model();
 
-    if(!robot_hw_sim_->initSim(robot_ns, model_nh_, parent_model_, urdf_model_ptr, transmissions_))
+    for (size_t i = 0; i < partitions_.size(); ++i)
     {
-      ROS_FATAL_NAMED("gazebo_ros_control","Could not initialize robot simulation interface");
-      return;
+      ControlPartition& partition = *partitions_[i];
+      partition.robot_hw_sim_ = control_host_ ? control_host_->createRobotHWSim(partition.robot_hw_sim_type_) :
+        robot_hw_sim_loader_->createInstance(partition.robot_hw_sim_type_);
+
+      if(!partition.robot_hw_sim_->initSim(robot_ns, model_nh_, parent_model_, urdf_model_ptr,
+                                           partition.transmissions_))
+      {
+        ROS_FATAL_NAMED("gazebo_ros_control","Could not initialize robot simulation interface");
+        return;
+      }
+
+      // Create the controller manager, in a namespace of its own for the named partitions
+      ROS_DEBUG_STREAM_NAMED("ros_control_plugin","Loading controller_manager");
+      const ros::NodeHandle cm_nh = partition.name_.empty() ? model_nh_ : ros::NodeHandle(model_nh_, partition.name_);
+      partition.controller_manager_.reset
+        (new controller_manager::ControllerManager(partition.robot_hw_sim_.get(), cm_nh));
     }
+    robot_hw_sim_ = partitions_.front()->robot_hw_sim_;
+    controller_manager_ = partitions_.front()->controller_manager_;
+    due_partitions_.reserve(partitions_.size());
 
-    // Create the controller manager
-    ROS_DEBUG_STREAM_NAMED("ros_control_plugin","Loading controller_manager");
-    controller_manager_.reset
-      (new controller_manager::ControllerManager(robot_hw_sim_.get(), model_nh_));
+    if (control_thread)
+    {
+      control_thread_ = boost::thread(boost::bind(&GazeboRosControlPlugin::controlThread, this));
+      ROS_INFO_STREAM_NAMED("gazebo_ros_control","Updating the controllers on a control thread"
+        << (control_delay_ ? ", their commands are applied one simulation step later." : "."));
+    }
 
-    // Listen to the update event. This event is broadcast every simulation iteration.
-    update_connection_ =
-      gazebo::event::Events::ConnectWorldUpdateBegin
-      (boost::bind(&GazeboRosControlPlugin::Update, this));
+    if (control_host_)
+    {
+      control_host_->addRobot(this);
+      ROS_INFO_STREAM_NAMED("gazebo_ros_control","Updating the controllers on the control host of the world.");
+    }
+    else
+    {
+      // Listen to the update event. This event is broadcast every simulation iteration.
+      update_connection_ =
+        gazebo::event::Events::ConnectWorldUpdateBegin
+        (boost::bind(&GazeboRosControlPlugin::Update, this));
+    }
 
   }
   catch(pluginlib::LibraryLoadException &ex)
@@ -210,57 +316,196 @@ void GazeboRosControlPlugin::Load(gazebo::physics::ModelPtr parent, sdf::Element
 // Called by the world update start event
 void GazeboRosControlPlugin::Update()
 {
-  // Get the simulation time and period
+  // Get the simulation time
 #if GAZEBO_MAJOR_VERSION >= 8
   gazebo::common::Time gz_time_now = parent_model_->GetWorld()->SimTime();
 #else
   gazebo::common::Time gz_time_now = parent_model_->GetWorld()->GetSimTime();
 #endif
   ros::Time sim_time_ros(gz_time_now.sec, gz_time_now.nsec);
-  ros::Duration sim_period = sim_time_ros - last_update_sim_time_ros_;
-
-  robot_hw_sim_->eStopActive(e_stop_active_);
 
-  // Check if we should update the controllers
-  if(sim_period >= control_period_) {
-    // Store this simulation time
-    last_update_sim_time_ros_ = sim_time_ros;
+  // The control thread owns the robot simulation interfaces until its step is done. With the one
+  // step delay it ran along the last physics step, it is late if it is still running.
+  if (control_thread_.joinable() && !waitForControl())
+  {
+    ++control_overruns_;
+    ROS_WARN_STREAM_THROTTLE_NAMED(10, "gazebo_ros_control","The controllers overran the simulation "
+      "step " << control_overruns_ << " times, the physics step waited for them.");
+  }
 
-    // Update the robot simulation with the state of the gazebo model
-    robot_hw_sim_->readSim(sim_time_ros, sim_period);
+  const bool due = readRobot(sim_time_ros);
 
-    // Compute the controller commands
-    bool reset_ctrlrs;
-    if (e_stop_active_)
+  // Compute the controller commands
+  if (due)
+  {
+    if (!control_thread_.joinable())
+    {
+      updateRobot(sim_time_ros);
+    }
+    else if (!control_delay_)
     {
-      reset_ctrlrs = false;
-      last_e_stop_active_ = true;
+      startControl(sim_time_ros);
+      waitForControl();
     }
     else
     {
-      if (last_e_stop_active_)
-      {
-        reset_ctrlrs = true;
-        last_e_stop_active_ = false;
-      }
-      else
-      {
-        reset_ctrlrs = false;
-      }
+      // Apply the previous commands to this physics step, the new ones to the next one
+      writeRobot(sim_time_ros);
+      startControl(sim_time_ros);
+      return;
     }
-    controller_manager_->update(sim_time_ros, sim_period, reset_ctrlrs);
   }
 
   // Update the gazebo model with the result of the controller
   // computation
-  robot_hw_sim_->writeSim(sim_time_ros, sim_time_ros - last_write_sim_time_ros_);
-  last_write_sim_time_ros_ = sim_time_ros;
+  writeRobot(sim_time_ros);
+}
+
+// Update the robot simulations of the due partitions with the state of the gazebo model
+bool GazeboRosControlPlugin::readRobot(const ros::Time& sim_time_ros)
+{
+  // A partition not due in this step resets its controllers on its next update
+  if (resetControllers())
+  {
+    for (size_t i = 0; i < partitions_.size(); ++i)
+      partitions_[i]->reset_controllers_ = true;
+  }
+
+  for (size_t i = 0; i < partitions_.size(); ++i)
+    partitions_[i]->robot_hw_sim_->eStopActive(e_stop_active_);
+
+  // Rate-monotonic schedule: the partitions are sorted by period, the fastest ones are read and
+  // updated first and the slow ones only in the steps where their period elapsed
+  schedule_.due(sim_time_ros, due_partitions_);
+  for (size_t k = 0; k < due_partitions_.size(); ++k)
+  {
+    const size_t i = due_partitions_[k];
+    if (i == 0)
+      last_update_sim_time_ros_ = sim_time_ros;
+
+    // Update the robot simulation with the state of the gazebo model
+    partitions_[i]->robot_hw_sim_->readSim(sim_time_ros, schedule_.updatePeriod(i));
+  }
+
+  return !due_partitions_.empty();
+}
+
+// Apply the commands of all partitions to the gazebo model
+void GazeboRosControlPlugin::writeRobot(const ros::Time& time)
+{
+  for (size_t i = 0; i < partitions_.size(); ++i)
+  {
+    ControlPartition& partition = *partitions_[i];
+    partition.robot_hw_sim_->writeSim(time, time - partition.last_write_sim_time_ros_);
+    partition.last_write_sim_time_ros_ = time;
+  }
+  last_write_sim_time_ros_ = time;
+}
+
+// Update the controllers of the partitions due in this step
+void GazeboRosControlPlugin::updateRobot(const ros::Time& time)
+{
+  for (size_t k = 0; k < due_partitions_.size(); ++k)
+  {
+    const size_t i = due_partitions_[k];
+    ControlPartition& partition = *partitions_[i];
+    partition.controller_manager_->update(time, schedule_.updatePeriod(i), partition.reset_controllers_);
+    partition.reset_controllers_ = false;
+  }
+}
+
+// Whether the controllers are reset, after the emergency stop is released
+bool GazeboRosControlPlugin::resetControllers()
+{
+  if (e_stop_active_)
+  {
+    last_e_stop_active_ = true;
+    return false;
+  }
+  if (last_e_stop_active_)
+  {
+    last_e_stop_active_ = false;
+    return true;
+  }
+  return false;
+}
+
+// Hand the controller updates over to the control thread
+void GazeboRosControlPlugin::startControl(const ros::Time& time)
+{
+  control_time_ = time;
+  control_requested_.fetch_add(1, boost::memory_order_release);
+  // The control thread also polls, a notification lost while it is about to wait only delays it
+  control_cond_.notify_one();
+}
+
+// Wait until the control thread finished its step
+bool GazeboRosControlPlugin::waitForControl()
+{
+  const unsigned long requested = control_requested_.load(boost::memory_order_relaxed);
+  if (control_completed_.load(boost::memory_order_acquire) == requested)
+    return true;
+  while (control_completed_.load(boost::memory_order_acquire) != requested)
+    boost::this_thread::yield();
+  return false;
+}
+
+// Update the controllers handed over by the physics step
+void GazeboRosControlPlugin::controlThread()
+{
+#ifdef __linux__
+  if (control_cpu_ >= 0)
+  {
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(control_cpu_, &cpus);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) != 0)
+      ROS_WARN_STREAM_NAMED("gazebo_ros_control","Could not pin the control thread to CPU " << control_cpu_);
+  }
+  if (control_priority_ > 0)
+  {
+    sched_param param;
+    param.sched_priority = control_priority_;
+    if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) != 0)
+      ROS_WARN_STREAM_NAMED("gazebo_ros_control","Could not give the control thread the real-time "
+        "priority " << control_priority_);
+  }
+#endif
+
+  unsigned long done = 0;
+  for (;;)
+  {
+    // The next step is at most a physics step away, spin a little before sleeping
+    unsigned int spins = 0;
+    while (!control_stop_ && control_requested_.load(boost::memory_order_acquire) == done)
+    {
+      if (++spins < 1000)
+      {
+        boost::this_thread::yield();
+        continue;
+      }
+      boost::mutex::scoped_lock lock(control_mutex_);
+      if (!control_stop_ && control_requested_.load(boost::memory_order_acquire) == done)
+        control_cond_.timed_wait(lock, boost::posix_time::milliseconds(1));
+    }
+    if (control_stop_)
+      return;
+
+    updateRobot(control_time_);
+
+    control_completed_.store(++done, boost::memory_order_release);
+  }
 }
 
 // Called on world reset
 void GazeboRosControlPlugin::Reset()
 {
   // Reset timing variables to not pass negative update periods to controllers on world reset
+  schedule_.reset();
+  for (size_t i = 0; i < partitions_.size(); ++i)
+  {
+    partitions_[i]->last_write_sim_time_ros_ = ros::Time();
+  }
   last_update_sim_time_ros_ = ros::Time();
   last_write_sim_time_ros_ = ros::Time();
 }
@@ -270,26 +515,37 @@ std::string GazeboRosControlPlugin::getURDF(std::string param_name) const
 {
   std::string urdf_string;
 
-  // search and wait for robot_description on param server
+  // search and wait for robot_description on param server. The parameter in the robot namespace
+  // is read from the parameter cache every 10 ms, which the master updates as soon as the
+  // parameter is set. The parent namespaces are still searched on the server, at the previous
+  // rate.
+  const ros::WallDuration search_period(0.1);
+  ros::WallTime next_search;
   while (urdf_string.empty())
   {
-    std::string search_param_name;
-    if (model_nh_.searchParam(param_name, search_param_name))
-    {
-      ROS_INFO_ONCE_NAMED("gazebo_ros_control", "gazebo_ros_control plugin is waiting for model"
-        " URDF in parameter [%s] on the ROS param server.", search_param_name.c_str());
-
-      model_nh_.getParam(search_param_name, urdf_string);
-    }
-    else
+    if (ros::WallTime::now() >= next_search)
     {
-      ROS_INFO_ONCE_NAMED("gazebo_ros_control", "gazebo_ros_control plugin is waiting for model"
-        " URDF in parameter [%s] on the ROS param server.", robot_description_.c_str());
+      std::string search_param_name;
+      if (model_nh_.searchParam(param_name, search_param_name))
+      {
+        ROS_INFO_ONCE_NAMED("gazebo_ros_control", "gazebo_ros_control plugin is waiting for model"
+          " URDF in parameter [%s] on the ROS param server.", search_param_name.c_str());
 
-      model_nh_.getParam(param_name, urdf_string);
+        model_nh_.getParam(search_param_name, urdf_string);
+        if (!urdf_string.empty())
+          break;
+      }
+      else
+      {
+        ROS_INFO_ONCE_NAMED("gazebo_ros_control", "gazebo_ros_control plugin is waiting for model"
+          " URDF in parameter [%s] on the ROS param server.", robot_description_.c_str());
+      }
+      next_search = ros::WallTime::now() + search_period;
     }
 
-    std::this_thread::sleep_for(std::chrono::microseconds(100000));
+    if (model_nh_.getParamCached(param_name, urdf_string) && !urdf_string.empty())
+      break;
+    ros::WallDuration(0.01).sleep();
   }
   ROS_DEBUG_STREAM_NAMED("gazebo_ros_control", "Recieved urdf from param server, parsing...");
 
@@ -299,7 +555,114 @@ std::string GazeboRosControlPlugin::getURDF(std::string param_name) const
 // Get Transmissions from the URDF
 bool GazeboRosControlPlugin::parseTransmissionsFromURDF(const std::string& urdf_string)
 {
-  transmission_interface::TransmissionParser::parse(urdf_string, transmissions_);
+  // Parsed once for all robots of the same URDF
+  description_ = RobotDescription::get(urdf_string);
+  transmissions_ = description_->transmissions();
+  return true;
+}
+
+// Split the transmissions into the <partition> elements of the plugin, or a single partition
+bool GazeboRosControlPlugin::loadPartitions(const ros::Duration& gazebo_period)
+{
+  partitions_.clear();
+  schedule_ = ControlSchedule();
+
+  // All transmissions in the namespace of the plugin
+  if (!sdf_->HasElement("partition"))
+  {
+    ControlPartitionPtr partition(new ControlPartition());
+    partition->robot_hw_sim_type_ = robot_hw_sim_type_str_;
+    partition->control_period_ = control_period_;
+    partition->transmissions_ = transmissions_;
+    partition->reset_controllers_ = false;
+    partitions_.push_back(partition);
+    schedule_.add(partition->control_period_);
+    return true;
+  }
+
+  std::vector<bool> assigned(transmissions_.size(), false);
+  for (sdf::ElementPtr element = sdf_->GetElement("partition"); element;
+       element = element->GetNextElement("partition"))
+  {
+    ControlPartitionPtr partition(new ControlPartition());
+    partition->reset_controllers_ = false;
+
+    if (element->HasElement("name"))
+    {
+      partition->name_ = element->Get<std::string>("name");
+    }
+    if (partition->name_.empty())
+    {
+      ROS_ERROR_STREAM_NAMED("gazebo_ros_control","A <partition> has no <name>, the namespace of its "
+        "controller manager.");
+      return false;
+    }
+    for (size_t i = 0; i < partitions_.size(); ++i)
+    {
+      if (partitions_[i]->name_ == partition->name_)
+      {
+        ROS_ERROR_STREAM_NAMED("gazebo_ros_control","Partition '" << partition->name_ << "' is declared twice.");
+        return false;
+      }
+    }
+
+    partition->robot_hw_sim_type_ = element->HasElement("robotSimType") ?
+      element->Get<std::string>("robotSimType") : robot_hw_sim_type_str_;
+
+    partition->control_period_ = element->HasElement("controlPeriod") ?
+      ros::Duration(element->Get<double>("controlPeriod")) : control_period_;
+    if (partition->control_period_ < gazebo_period)
+    {
+      ROS_ERROR_STREAM_NAMED("gazebo_ros_control","Desired controller update period of partition '"
+        << partition->name_ << "' (" << partition->control_period_
+        << " s) is faster than the gazebo simulation period (" << gazebo_period << " s).");
+    }
+
+    // The transmissions of the joints of the partition
+    std::vector<std::string> joints;
+    if (element->HasElement("joints"))
+    {
+      std::istringstream names(element->Get<std::string>("joints"));
+      std::string name;
+      while (names >> name)
+        joints.push_back(name);
+    }
+    for (size_t i = 0; i < transmissions_.size(); ++i)
+    {
+      const transmission_interface::TransmissionInfo& transmission = transmissions_[i];
+      if (transmission.joints_.empty() ||
+          std::find(joints.begin(), joints.end(), transmission.joints_[0].name_) == joints.end())
+        continue;
+      if (assigned[i])
+      {
+        ROS_WARN_STREAM_NAMED("gazebo_ros_control","Transmission '" << transmission.name_
+          << "' is already in another partition, skipped in partition '" << partition->name_ << "'.");
+        continue;
+      }
+      assigned[i] = true;
+      partition->transmissions_.push_back(transmission);
+    }
+    if (partition->transmissions_.empty())
+    {
+      ROS_WARN_STREAM_NAMED("gazebo_ros_control","Partition '" << partition->name_
+        << "' has no transmission of its <joints>.");
+    }
+
+    ROS_INFO_STREAM_NAMED("gazebo_ros_control","Partition '" << partition->name_ << "' updates "
+      << partition->transmissions_.size() << " transmissions every " << partition->control_period_ << " s.");
+
+    // Rate-monotonic order, the fastest partitions first
+    partitions_.insert(partitions_.begin() + schedule_.add(partition->control_period_), partition);
+  }
+
+  for (size_t i = 0; i < transmissions_.size(); ++i)
+  {
+    if (!assigned[i])
+    {
+      ROS_WARN_STREAM_NAMED("gazebo_ros_control","Transmission '" << transmissions_[i].name_
+        << "' is in no partition, it is not simulated.");
+    }
+  }
   return true;
 }
 
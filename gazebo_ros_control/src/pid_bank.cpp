@@ -0,0 +1,160 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+#include <gazebo_ros_control/pid_bank.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace
+{
+
+// One pass over n controllers with finite errors. The arrays do not overlap, which lets the
+// compiler vectorize the loop.
+void updatePids(const std::size_t n, const double dt,
+                const double* __restrict errors, double* __restrict commands,
+                const double* __restrict p_gain, const double* __restrict i_gain,
+                const double* __restrict d_gain, const double* __restrict i_min,
+                const double* __restrict i_max, const double* __restrict i_error_min,
+                const double* __restrict i_error_max, const double* __restrict antiwindup,
+                double* __restrict i_error, double* __restrict p_error_last)
+{
+  const double inv_dt = 1.0 / dt;
+  for (std::size_t i = 0; i < n; i++)
+  {
+    const double error = errors[i];
+    const double error_dot = (error - p_error_last[i]) * inv_dt;
+    p_error_last[i] = error;
+
+    // With anti windup the integrated error is bounded, without it the integral term is.
+    const double integral = std::min(std::max(i_error[i] + dt * error, i_error_min[i]),
+                                     i_error_max[i]);
+    i_error[i] = integral;
+    const double i_term_free = i_gain[i] * integral;
+    const double i_term_clamped = std::min(std::max(i_term_free, i_min[i]), i_max[i]);
+    const double i_term = antiwindup[i] != 0.0 ? i_term_free : i_term_clamped;
+
+    commands[i] = p_gain[i] * error + i_term + d_gain[i] * error_dot;
+  }
+}
+
+}
+
+namespace gazebo_ros_control
+{
+
+std::size_t PidBank::add(const control_toolbox::Pid::Gains& gains)
+{
+  const std::size_t i = size();
+  p_gain_.push_back(0.0);
+  i_gain_.push_back(0.0);
+  d_gain_.push_back(0.0);
+  i_min_.push_back(0.0);
+  i_max_.push_back(0.0);
+  i_error_min_.push_back(0.0);
+  i_error_max_.push_back(0.0);
+  antiwindup_.push_back(0.0);
+  i_error_.push_back(0.0);
+  p_error_last_.push_back(0.0);
+  setGains(i, gains);
+  return i;
+}
+
+void PidBank::setGains(const std::size_t i, const control_toolbox::Pid::Gains& gains)
+{
+  p_gain_[i] = gains.p_gain_;
+  i_gain_[i] = gains.i_gain_;
+  d_gain_[i] = gains.d_gain_;
+  i_min_[i] = gains.i_min_;
+  i_max_[i] = gains.i_max_;
+  antiwindup_[i] = gains.antiwindup_ ? 1.0 : 0.0;
+
+  // Pid bounds the integrated error by i_min / |i_gain| and i_max / |i_gain| with anti windup,
+  // without an integral gain the integral term is 0 whatever the bounds.
+  const double abs_i_gain = std::abs(gains.i_gain_);
+  if (gains.antiwindup_ && abs_i_gain > 0.0)
+  {
+    i_error_min_[i] = gains.i_min_ / abs_i_gain;
+    i_error_max_[i] = gains.i_max_ / abs_i_gain;
+  }
+  else
+  {
+    i_error_min_[i] = -std::numeric_limits<double>::infinity();
+    i_error_max_[i] = std::numeric_limits<double>::infinity();
+  }
+}
+
+void PidBank::reset()
+{
+  std::fill(i_error_.begin(), i_error_.end(), 0.0);
+  std::fill(p_error_last_.begin(), p_error_last_.end(), 0.0);
+}
+
+void PidBank::computeCommands(const std::size_t begin, const std::size_t end,
+                              const double* errors, double* commands, const double dt)
+{
+  if (!(dt > 0.0))
+  {
+    std::fill(commands + begin, commands + end, 0.0);
+    return;
+  }
+
+  // A selection on the error would keep the compiler from vectorizing the update, so NaN and
+  // infinite errors are looked for first and the controllers around them updated in runs.
+  std::size_t run_begin = begin;
+  for (std::size_t i = begin; i < end; i++)
+  {
+    if (std::isfinite(errors[i]))
+      continue;
+    update(run_begin, i, errors, commands, dt);
+    commands[i] = 0.0;
+    run_begin = i + 1;
+  }
+  update(run_begin, end, errors, commands, dt);
+}
+
+void PidBank::update(const std::size_t begin, const std::size_t end,
+                     const double* errors, double* commands, const double dt)
+{
+  if (begin >= end)
+    return;
+  updatePids(end - begin, dt, errors + begin, commands + begin,
+             &p_gain_[begin], &i_gain_[begin], &d_gain_[begin], &i_min_[begin], &i_max_[begin],
+             &i_error_min_[begin], &i_error_max_[begin], &antiwindup_[begin],
+             &i_error_[begin], &p_error_last_[begin]);
+}
+
+}
@@ -0,0 +1,118 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Robot descriptions parsed once per process, shared by the robots of the same type.
+*/
+
+#include <map>
+
+#include <boost/functional/hash.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include <ros/console.h>
+#include <transmission_interface/transmission_parser.h>
+
+#include <gazebo_ros_control/robot_description.h>
+
+namespace gazebo_ros_control
+{
+
+namespace
+{
+// Descriptions by the hash of their URDF, robots load from different threads
+typedef std::vector<boost::weak_ptr<const RobotDescription> > Descriptions;
+boost::mutex g_descriptions_mutex;
+std::map<std::size_t, Descriptions> g_descriptions;
+}
+
+RobotDescription::RobotDescription(const std::string& urdf_string) :
+  urdf_(urdf_string)
+{
+  model_valid_ = model_.initString(urdf_);
+  transmission_interface::TransmissionParser::parse(urdf_, transmissions_);
+}
+
+// The parsed description of urdf_string, parsed on the first call with its content
+RobotDescriptionConstPtr RobotDescription::get(const std::string& urdf_string)
+{
+  const std::size_t hash = boost::hash<std::string>()(urdf_string);
+
+  // Parsing under the lock lets robots of the same type loading at once wait for the first parse
+  boost::mutex::scoped_lock lock(g_descriptions_mutex);
+
+  // forget the descriptions of removed robots, along with the hashes left without one
+  for (std::map<std::size_t, Descriptions>::iterator it = g_descriptions.begin();
+       it != g_descriptions.end();)
+  {
+    Descriptions& descriptions = it->second;
+    for (Descriptions::iterator jt = descriptions.begin(); jt != descriptions.end();)
+    {
+      if (jt->expired())
+        jt = descriptions.erase(jt);
+      else
+        ++jt;
+    }
+    if (descriptions.empty())
+      g_descriptions.erase(it++);
+    else
+      ++it;
+  }
+
+  Descriptions& descriptions = g_descriptions[hash];
+  RobotDescriptionConstPtr description;
+  for (Descriptions::iterator it = descriptions.begin(); it != descriptions.end(); ++it)
+  {
+    // Robots of different types may share a hash
+    RobotDescriptionConstPtr candidate = it->lock();
+    if (candidate && candidate->urdf() == urdf_string)
+    {
+      description = candidate;
+      break;
+    }
+  }
+
+  if (description)
+  {
+    ROS_DEBUG_STREAM_NAMED("gazebo_ros_control","Reusing the parsed robot description.");
+    return description;
+  }
+
+  description.reset(new RobotDescription(urdf_string));
+  descriptions.push_back(description);
+  return description;
+}
+
+}
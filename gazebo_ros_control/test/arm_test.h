@@ -0,0 +1,103 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Commands the joint of the robots spawned from arm.urdf.xacro and waits for it in gazebo.
+*/
+
+#ifndef _GAZEBO_ROS_CONTROL___TEST_ARM_TEST_H_
+#define _GAZEBO_ROS_CONTROL___TEST_ARM_TEST_H_
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <gazebo_msgs/GetJointProperties.h>
+#include <ros/ros.h>
+#include <std_msgs/Float64.h>
+
+class ArmTest : public ::testing::Test
+{
+protected:
+  // Wait for gazebo and the position controller of a robot
+  bool waitForRobot(const std::string& robot, const double timeout)
+  {
+    if (!ros::service::waitForService("/gazebo/get_joint_properties", ros::Duration(timeout)))
+      return false;
+    joint_properties_ = nh_.serviceClient<gazebo_msgs::GetJointProperties>("/gazebo/get_joint_properties");
+
+    ros::Publisher& publisher = commands_[robot];
+    publisher = nh_.advertise<std_msgs::Float64>(robot + "/joint_position_controller/command", 1);
+    const ros::WallTime end = ros::WallTime::now() + ros::WallDuration(timeout);
+    while (publisher.getNumSubscribers() == 0 && ros::ok() && ros::WallTime::now() < end)
+      ros::WallDuration(0.1).sleep();
+    return publisher.getNumSubscribers() > 0;
+  }
+
+  // Position of the joint of a robot in gazebo, NaN if it is not known
+  double jointPosition(const std::string& robot)
+  {
+    gazebo_msgs::GetJointProperties srv;
+    srv.request.joint_name = robot + "::joint";
+    if (!joint_properties_.call(srv) || !srv.response.success || srv.response.position.empty())
+      return std::nan("");
+    return srv.response.position[0];
+  }
+
+  // Command the joint of a robot to a position and wait until it is there. The command is sent
+  // again while waiting, in case the controller was only started in the meantime, which resets
+  // its command to the current position.
+  bool commandJoint(const std::string& robot, const double position, const double timeout)
+  {
+    std_msgs::Float64 command;
+    command.data = position;
+    const ros::WallTime end = ros::WallTime::now() + ros::WallDuration(timeout);
+    while (ros::ok() && ros::WallTime::now() < end)
+    {
+      commands_[robot].publish(command);
+      if (std::abs(jointPosition(robot) - position) < 1e-3)
+        return true;
+      ros::WallDuration(0.1).sleep();
+    }
+    return false;
+  }
+
+  ros::NodeHandle nh_;
+  ros::ServiceClient joint_properties_;
+  std::map<std::string, ros::Publisher> commands_;
+};
+
+#endif // #ifndef _GAZEBO_ROS_CONTROL___TEST_ARM_TEST_H_
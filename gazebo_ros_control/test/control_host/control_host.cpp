@@ -0,0 +1,67 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Checks that the control host updates the controllers of two robots, each moving the
+           joint of its own robot only.
+*/
+
+#include "../arm_test.h"
+
+class ControlHostTest : public ArmTest
+{
+};
+
+TEST_F(ControlHostTest, twoRobots)
+{
+  ASSERT_TRUE(waitForRobot("/robot1", 60.0));
+  ASSERT_TRUE(waitForRobot("/robot2", 60.0));
+
+  // different positions, a robot moved by the commands of the other one fails
+  EXPECT_TRUE(commandJoint("/robot1", 0.5, 20.0));
+  EXPECT_TRUE(commandJoint("/robot2", -0.7, 20.0));
+  EXPECT_NEAR(0.5, jointPosition("/robot1"), 1e-3);
+
+  // the host keeps updating both robots
+  EXPECT_TRUE(commandJoint("/robot2", 0.9, 20.0));
+  EXPECT_TRUE(commandJoint("/robot1", -0.3, 20.0));
+  EXPECT_NEAR(0.9, jointPosition("/robot2"), 1e-3);
+}
+
+int main(int argc, char **argv)
+{
+  ros::init(argc, argv, "control_host_test");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
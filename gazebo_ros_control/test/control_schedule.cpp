@@ -0,0 +1,152 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Checks the rate-monotonic schedule of the partitions of gazebo_ros_control.
+*/
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <gazebo_ros_control/control_schedule.h>
+
+using gazebo_ros_control::ControlSchedule;
+
+namespace
+{
+
+// Simulation time of a step of 1 ms
+ros::Time stepTime(const unsigned int step)
+{
+  return ros::Time(step / 1000, (step % 1000) * 1000000);
+}
+
+}
+
+// Partitions are sorted by period, the fastest first, equal periods in the order they were added
+TEST(ControlScheduleTest, fastestFirst)
+{
+  ControlSchedule schedule;
+  EXPECT_EQ(0u, schedule.add(ros::Duration(0.01)));
+  EXPECT_EQ(0u, schedule.add(ros::Duration(0.001)));
+  EXPECT_EQ(2u, schedule.add(ros::Duration(0.1)));
+  EXPECT_EQ(2u, schedule.add(ros::Duration(0.01)));
+
+  ASSERT_EQ(4u, schedule.size());
+  EXPECT_EQ(ros::Duration(0.001), schedule.period(0));
+  EXPECT_EQ(ros::Duration(0.01), schedule.period(1));
+  EXPECT_EQ(ros::Duration(0.01), schedule.period(2));
+  EXPECT_EQ(ros::Duration(0.1), schedule.period(3));
+}
+
+// A slow partition is only due in the steps where its period elapsed, after the fast ones
+TEST(ControlScheduleTest, multiRate)
+{
+  ControlSchedule schedule;
+  schedule.add(ros::Duration(0.01));
+  schedule.add(ros::Duration(0.001));
+
+  std::vector<std::size_t> due;
+  unsigned int fast_updates = 0, slow_updates = 0;
+  for (unsigned int step = 1; step <= 100; ++step)
+  {
+    schedule.due(stepTime(step), due);
+    ASSERT_FALSE(due.empty());
+    EXPECT_EQ(0u, due[0]);
+    ++fast_updates;
+    EXPECT_EQ(ros::Duration(0.001), schedule.updatePeriod(0));
+
+    if (step % 10 == 0)
+    {
+      ASSERT_EQ(2u, due.size()) << "step " << step;
+      EXPECT_EQ(1u, due[1]);
+      ++slow_updates;
+      EXPECT_EQ(ros::Duration(0.01), schedule.updatePeriod(1));
+    }
+    else
+    {
+      EXPECT_EQ(1u, due.size()) << "step " << step;
+    }
+  }
+  EXPECT_EQ(100u, fast_updates);
+  EXPECT_EQ(10u, slow_updates);
+}
+
+// A period that is not a multiple of the step is updated at the first step after it elapsed
+TEST(ControlScheduleTest, unevenPeriod)
+{
+  ControlSchedule schedule;
+  schedule.add(ros::Duration(0.0025));
+
+  std::vector<std::size_t> due;
+  std::vector<unsigned int> due_steps;
+  for (unsigned int step = 1; step <= 9; ++step)
+  {
+    schedule.due(stepTime(step), due);
+    if (!due.empty())
+      due_steps.push_back(step);
+  }
+  ASSERT_EQ(3u, due_steps.size());
+  EXPECT_EQ(3u, due_steps[0]);
+  EXPECT_EQ(6u, due_steps[1]);
+  EXPECT_EQ(9u, due_steps[2]);
+  EXPECT_EQ(ros::Duration(0.003), schedule.updatePeriod(0));
+}
+
+// After a reset all partitions are due again
+TEST(ControlScheduleTest, reset)
+{
+  ControlSchedule schedule;
+  schedule.add(ros::Duration(0.001));
+  schedule.add(ros::Duration(0.01));
+
+  std::vector<std::size_t> due;
+  schedule.due(stepTime(10), due);
+  EXPECT_EQ(2u, due.size());
+  schedule.due(stepTime(11), due);
+  EXPECT_EQ(1u, due.size());
+
+  // the world restarts at time 0
+  schedule.reset();
+  schedule.due(stepTime(10), due);
+  EXPECT_EQ(2u, due.size());
+  EXPECT_EQ(ros::Duration(0.01), schedule.updatePeriod(1));
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
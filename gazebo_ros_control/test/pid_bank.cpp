@@ -0,0 +1,206 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Checks that a PidBank computes the commands of control_toolbox::Pid.
+*/
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <control_toolbox/pid.h>
+#include <gazebo_ros_control/pid_bank.h>
+
+namespace
+{
+
+const double tolerance = 1e-9;
+
+// Controllers stepped one Pid at a time and by a bank, with the same gains
+class PidBankTest : public ::testing::Test
+{
+protected:
+  void add(const double p, const double i, const double d, const double i_max, const double i_min,
+           const bool antiwindup)
+  {
+    pids_.push_back(control_toolbox::Pid());
+    pids_.back().initPid(p, i, d, i_max, i_min, antiwindup);
+    bank_.add(pids_.back().getGains());
+  }
+
+  // Step all controllers with errors(step, joint) and compare their commands
+  template <class Errors>
+  void compare(const int steps, const double dt, Errors errors)
+  {
+    const std::size_t n = pids_.size();
+    std::vector<double> error(n);
+    std::vector<double> bank_commands(n);
+    for (int step = 0; step < steps; ++step)
+    {
+      for (std::size_t j = 0; j < n; ++j)
+        error[j] = errors(step, j);
+      bank_.computeCommands(0, n, &error[0], &bank_commands[0], dt);
+      for (std::size_t j = 0; j < n; ++j)
+      {
+        const double pid_command = pids_[j].computeCommand(error[j], ros::Duration(dt));
+        ASSERT_NEAR(pid_command, bank_commands[j], tolerance * std::max(1.0, std::abs(pid_command)))
+          << "joint " << j << " step " << step;
+      }
+    }
+  }
+
+  // Gains covering the integral limits with and without anti windup
+  void addGains()
+  {
+    add(100.0, 0.0, 0.0, 0.0, 0.0, false);
+    add(100.0, 10.0, 1.0, 0.5, -0.5, false);
+    add(100.0, 10.0, 1.0, 0.5, -0.5, true);
+    add(50.0, -20.0, 2.0, 0.2, -0.1, true);
+    add(50.0, 200.0, 0.5, 1.0, -2.0, false);
+    add(10.0, 1.0, 0.0, 100.0, -100.0, true);
+    add(0.0, 0.0, 5.0, 0.0, 0.0, true);
+  }
+
+  std::vector<control_toolbox::Pid> pids_;
+  gazebo_ros_control::PidBank bank_;
+};
+
+// Errors large and long enough to saturate the integral terms
+double saturating(const int step, const std::size_t joint)
+{
+  return 0.5 * std::sin(0.01 * step + joint) + (step < 500 ? 0.3 : -0.6);
+}
+
+}
+
+TEST_F(PidBankTest, matchesPid)
+{
+  addGains();
+  compare(2000, 0.001, saturating);
+}
+
+// The integral terms saturate within a few steps
+TEST_F(PidBankTest, clampsIntegral)
+{
+  addGains();
+  compare(300, 0.1, saturating);
+}
+
+TEST_F(PidBankTest, setGains)
+{
+  addGains();
+  compare(200, 0.001, saturating);
+  for (std::size_t j = 0; j < pids_.size(); ++j)
+  {
+    pids_[j].setGains(20.0, 30.0, 0.1, 0.05, -0.05, j % 2 == 0);
+    bank_.setGains(j, pids_[j].getGains());
+  }
+  compare(500, 0.001, saturating);
+}
+
+// Like Pid, a zero dt commands 0 and keeps the state
+TEST_F(PidBankTest, zeroPeriod)
+{
+  addGains();
+  compare(100, 0.001, saturating);
+  compare(3, 0.0, saturating);
+  compare(100, 0.001, saturating);
+}
+
+// A negative dt commands 0 and keeps the state, the bank then goes on like a Pid that did not
+// see the step
+TEST_F(PidBankTest, negativePeriod)
+{
+  addGains();
+  compare(100, 0.001, saturating);
+
+  std::vector<double> error(pids_.size(), 0.2);
+  std::vector<double> commands(pids_.size(), 1.0);
+  bank_.computeCommands(0, pids_.size(), &error[0], &commands[0], -0.001);
+  for (std::size_t j = 0; j < commands.size(); ++j)
+    EXPECT_EQ(0.0, commands[j]);
+
+  compare(100, 0.001, saturating);
+}
+
+// Like Pid, a NaN or infinite error commands 0 and keeps the state of its controller only
+TEST_F(PidBankTest, nonFiniteErrors)
+{
+  addGains();
+  compare(1000, 0.001, [](const int step, const std::size_t joint)
+    {
+      if (static_cast<std::size_t>(step % 7) == joint % 3)
+        return std::numeric_limits<double>::quiet_NaN();
+      if (step % 11 == 5 && joint == 2)
+        return std::numeric_limits<double>::infinity();
+      return saturating(step, joint);
+    });
+}
+
+// Ranges of the bank update their controllers only
+TEST_F(PidBankTest, ranges)
+{
+  addGains();
+  const std::size_t n = pids_.size();
+  std::vector<double> error(n);
+  std::vector<double> commands(n);
+  for (int step = 0; step < 500; ++step)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+      error[j] = saturating(step, j);
+    bank_.computeCommands(0, 3, &error[0], &commands[0], 0.001);
+    bank_.computeCommands(3, n, &error[0], &commands[0], 0.001);
+    for (std::size_t j = 0; j < n; ++j)
+      ASSERT_NEAR(pids_[j].computeCommand(error[j], ros::Duration(0.001)), commands[j], 1e-9);
+  }
+}
+
+TEST_F(PidBankTest, reset)
+{
+  addGains();
+  compare(300, 0.001, saturating);
+  for (std::size_t j = 0; j < pids_.size(); ++j)
+    pids_[j].reset();
+  bank_.reset();
+  compare(300, 0.001, saturating);
+}
+
+int main(int argc, char **argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,107 @@
+/*********************************************************************
+ * Software License Agreement (BSD License)
+ *
+ *  Copyright (c) 2026, Open Source Robotics Foundation
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *   * Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *   * Redistributions in binary form must reproduce the above
+ *     copyright notice, this list of conditions and the following
+ *     disclaimer in the documentation and/or other materials provided
+ *     with the distribution.
+ *   * Neither the name of the Open Source Robotics Foundation
+ *     nor the names of its contributors may be
+ *     used to endorse or promote products derived
+ *     from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS
+ *  FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *  COPYRIGHT OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT,
+ *  INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING,
+ *  BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ *  CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT
+ *  LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN
+ *  ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ *********************************************************************/
+
+/* Desc:   Times the PID joints of DefaultRobotHWSim computed one control_toolbox::Pid at a time
+           and by a PidBank.
+
+     pid_bank_benchmark [joints] [iterations]
+*/
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <control_toolbox/pid.h>
+#include <gazebo_ros_control/pid_bank.h>
+
+// Average time of one call of f in microseconds
+template<class F>
+static double timeIt(F f, const int iterations)
+{
+  const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (int i = 0; i < iterations; ++i)
+    f();
+  const std::chrono::duration<double, std::micro> elapsed =
+    std::chrono::steady_clock::now() - start;
+  return elapsed.count() / iterations;
+}
+
+int main(int argc, char **argv)
+{
+  const int joints = argc > 1 ? atoi(argv[1]) : 150;
+  const int iterations = argc > 2 ? atoi(argv[2]) : 100000;
+  if (joints < 1 || iterations < 1)
+  {
+    fprintf(stderr, "usage: %s [joints] [iterations]\n", argv[0]);
+    return 1;
+  }
+
+  // gains of a typical arm, half of them with anti windup
+  std::vector<control_toolbox::Pid> pids(joints);
+  gazebo_ros_control::PidBank bank;
+  for (int j = 0; j < joints; ++j)
+  {
+    pids[j].initPid(100.0 + j, 1.0, 10.0, 5.0, -5.0, j % 2 == 0);
+    bank.add(pids[j].getGains());
+  }
+
+  std::vector<double> errors(joints);
+  for (int j = 0; j < joints; ++j)
+    errors[j] = 0.01 * std::sin(0.1 * j);
+  std::vector<double> efforts(joints);
+
+  const ros::Duration period(0.001);
+  const double pid_us = timeIt([&]()
+    {
+      for (int j = 0; j < joints; ++j)
+        efforts[j] = pids[j].computeCommand(errors[j], period);
+    }, iterations);
+  const double pid_effort = efforts[joints - 1];
+
+  const double bank_us = timeIt([&]()
+    {
+      bank.computeCommands(0, joints, &errors[0], &efforts[0], period.toSec());
+    }, iterations);
+
+  printf("%d joints, %d iterations\n", joints, iterations);
+  printf("control_toolbox::Pid: %10.3f us per update, %8.2f ns per joint\n",
+         pid_us, 1e3 * pid_us / joints);
+  printf("PidBank:              %10.3f us per update, %8.2f ns per joint\n",
+         bank_us, 1e3 * bank_us / joints);
+  printf("last effort %g and %g\n", pid_effort, efforts[joints - 1]);
+  return 0;
+}